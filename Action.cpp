@@ -1,58 +1,45 @@
 // Author:   James Liao
 // Copyright  2017 DigiPen (USA) Corporation.
 #include "Action.h"
+#include "CharacterHandler.h"
 
-// Jump action class
-Jump::Jump(Direction direction)
+void Action::execute(Character* character)
 {
-  // Jump requires a direction to check if character wants to jump down through a platform
-  direction_ = direction;
+  // The character acts on this when CharacterManager dispatches the frame's commands
+  CharacterManager::SubmitInput(character->GetID(), verb_, direction_);
 }
 
-void Jump::execute(Character* character)
+
+// Jump action class
+Jump::Jump(Direction direction) : Action(VerbJump)
 {
-  character->jump(direction_);
+  // Jump requires a direction to check if character wants to jump down through a platform
+  direction_ = direction;
 }
 
 
 // Basic attack action class
-BasicAttack::BasicAttack(Direction direction)
+BasicAttack::BasicAttack(Direction direction) : Action(VerbBasicAttack)
 {
   direction_ = direction;
 }
 
-void BasicAttack::execute(Character* character)
-{
-  character->basicAttack(direction_);
-}
-
 
 // Special attack action class
-SpecialAttack::SpecialAttack(Direction direction)
+SpecialAttack::SpecialAttack(Direction direction) : Action(VerbSpecialAttack)
 {
   direction_ = direction;
 }
 
-void SpecialAttack::execute(Character* character)
-{
-  character->specialAttack(direction_);
-}
-
 
 // Block action class
-void Block::execute(Character* character)
+Block::Block() : Action(VerbBlock)
 {
-  character->block();
 }
 
 
 // Move action class
-Move::Move(Direction direction)
+Move::Move(Direction direction) : Action(VerbMove)
 {
   direction_ = direction;
-}
-
-void Move::execute(Character* character)
-{
-  character->move(direction_);
-}
+}
\ No newline at end of file
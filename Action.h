@@ -6,23 +6,27 @@
 \par     email: james.liao\@digipen.edu
 \par     Course: GAM200F17-A
 \brief   Implementation for Command Pattern actions for controller inputs.
+         Actions no longer call into the character directly, they write an
+         InputCommand into CharacterManager's per-frame command buffer.
 *******************************************************************************/
 
 #include "Character.h"
+#include "Direction.h"
+#include "InputCommand.h"
 
 #pragma once
 
-enum Direction;
-
-//! Abstract Action class
+//! Base Action class, the verb is fixed by the derived class so execute needs no virtual dispatch
 class Action
 {
   public:
     virtual ~Action() {} //!< Virtual destructor
-    virtual void execute(Character* character) = 0; //!< Virtual function for linking action to character
+    void execute(Character* character); //!< Submits this action for the character as an input command
     void setDirection(Direction direction) { direction_ = direction; }; //!< Stores the direction to be used by certan actions
     Direction getDirection() { return direction_; } //!< Returns the direction stored in this action
   protected:
+    Action(InputVerb verb) : verb_(verb), direction_() {} //!< Only derived actions pick a verb
+    InputVerb verb_; //!< What the action asks the character to do
     Direction direction_; //!< Direction that will be used by certain actions
 };
 
@@ -31,8 +35,6 @@ class Jump : public Action
 {
   public:
     Jump(Direction direction);
-
-    void execute(Character* character);
 };
 
 //! Action class for handling basic attacks
@@ -40,8 +42,6 @@ class BasicAttack : public Action
 {
   public:
     BasicAttack(Direction direction);
-
-    void execute(Character* character);
 };
 
 //! Action class for handling special attacks
@@ -49,15 +49,13 @@ class SpecialAttack : public Action
 {
   public:
     SpecialAttack(Direction direction);
-
-    void execute(Character* character);
 };
 
 //! Action class for handling blocking
 class Block : public Action
 {
   public:
-    void execute(Character* character);
+    Block();
 
     void setDirection(Direction direction) {}
 };
@@ -67,6 +65,4 @@ class Move : public Action
 {
   public:
     Move(Direction direction);
-
-    void execute(Character* character);
 };
\ No newline at end of file
@@ -0,0 +1,202 @@
+// Author:   James Liao
+// Copyright  2017 DigiPen (USA) Corporation.
+#include "BufferedCharacterSink.h"
+#include <algorithm>
+
+using namespace fb;
+
+void BufferedCharacterSink::Notify(int character, const evt::CharacterEvent& event, int count)
+{
+  Command command = { key_, NotifyCommand, character, static_cast<int>(events_.size()) };
+  events_.push_back(event);
+  eventCounts_.push_back(count);
+  commands_.push_back(command);
+}
+
+void BufferedCharacterSink::Particle(CharacterParticle type, float size, glm::vec2 position, bool flipped)
+{
+  Command command = { key_, ParticleCommand, type, 0, size };
+  command.position = position;
+  command.flag = flipped;
+  commands_.push_back(command);
+}
+
+void BufferedCharacterSink::Squash(const std::shared_ptr<Entity>& entity, float rotation, float duration, float scale)
+{
+  Command command = { key_, SquashCommand, 0, static_cast<int>(entities_.size()), rotation, duration, scale };
+  entities_.push_back(entity);
+  commands_.push_back(command);
+}
+
+void BufferedCharacterSink::Face(int character, bool left)
+{
+  Command command = { key_, FaceCommand, character };
+  command.flag = left;
+  commands_.push_back(command);
+}
+
+void BufferedCharacterSink::DeliveryPopup(int character, int weight, glm::vec2 position)
+{
+  Command command = { key_, DeliveryPopupCommand, character, weight };
+  command.position = position;
+  commands_.push_back(command);
+}
+
+void BufferedCharacterSink::EmptyPopup(int character, glm::vec2 position, bool screenspace)
+{
+  Command command = { key_, EmptyPopupCommand, character };
+  command.position = position;
+  command.flag = screenspace;
+  commands_.push_back(command);
+}
+
+void BufferedCharacterSink::Vibrate(int controller, float low, float high, float duration)
+{
+  Command command = { key_, VibrateCommand, controller, 0, low, high, duration };
+  commands_.push_back(command);
+}
+
+void BufferedCharacterSink::StopVibration(int controller)
+{
+  Command command = { key_, StopVibrationCommand, controller };
+  commands_.push_back(command);
+}
+
+void BufferedCharacterSink::CameraShake(float strength, float duration)
+{
+  Command command = { key_, CameraShakeCommand, 0, 0, strength, duration };
+  commands_.push_back(command);
+}
+
+void BufferedCharacterSink::CameraPing(glm::vec2 position, int weight)
+{
+  Command command = { key_, CameraPingCommand, weight };
+  command.position = position;
+  commands_.push_back(command);
+}
+
+void BufferedCharacterSink::Clear()
+{
+  commands_.clear();
+  events_.clear();
+  eventCounts_.clear();
+  entities_.clear();
+  key_ = 0;
+}
+
+void BufferedCharacterSink::ReplayInOrder(BufferedCharacterSink* buffers, int count, CharacterSink& target)
+{
+  // Only called from the main thread, so the scratch list can be reused between frames
+  static std::vector<std::pair<const BufferedCharacterSink*, const Command*> > order;
+  order.clear();
+
+  for (int i = 0; i < count; ++i)
+  {
+    for (const Command& command : buffers[i].commands_)
+    {
+      order.push_back(std::make_pair(&buffers[i], &command));
+    }
+  }
+
+  // Commands with the same key all come from one buffer, so a stable sort keeps their order
+  std::stable_sort(order.begin(), order.end(), [](const std::pair<const BufferedCharacterSink*, const Command*>& a,
+                                                 const std::pair<const BufferedCharacterSink*, const Command*>& b)
+  {
+    return a.second->key < b.second->key;
+  });
+
+  for (const auto& entry : order)
+  {
+    entry.first->Run(*entry.second, target);
+  }
+
+  order.clear();
+
+  for (int i = 0; i < count; ++i)
+  {
+    buffers[i].Clear();
+  }
+}
+
+void BufferedCharacterSink::ReplayByType(CharacterSink& target)
+{
+  // Only called from the main thread, so the scratch list can be reused between frames
+  static std::vector<const Command*> order;
+  order.clear();
+
+  for (const Command& command : commands_)
+  {
+    order.push_back(&command);
+  }
+
+  std::stable_sort(order.begin(), order.end(), [](const Command* a, const Command* b)
+  {
+    if (Group(a->type) != Group(b->type))
+    {
+      return Group(a->type) < Group(b->type);
+    }
+
+    // Particle type is the emitter to use
+    return a->type == ParticleCommand && a->value < b->value;
+  });
+
+  for (const Command* command : order)
+  {
+    Run(*command, target);
+  }
+
+  order.clear();
+  Clear();
+}
+
+BufferedCharacterSink::CommandType BufferedCharacterSink::Group(CommandType type)
+{
+  // A stop has to land after the vibration it ends, so both go to the haptics in the order they were made
+  return type == StopVibrationCommand ? VibrateCommand : type;
+}
+
+void BufferedCharacterSink::Run(const Command& command, CharacterSink& target) const
+{
+  switch (command.type)
+  {
+    case NotifyCommand:
+      target.Notify(command.value, events_[command.payload], eventCounts_[command.payload]);
+      break;
+
+    case ParticleCommand:
+      target.Particle(static_cast<CharacterParticle>(command.value), command.a, command.position, command.flag);
+      break;
+
+    case SquashCommand:
+      target.Squash(entities_[command.payload], command.a, command.b, command.c);
+      break;
+
+    case FaceCommand:
+      target.Face(command.value, command.flag);
+      break;
+
+    case DeliveryPopupCommand:
+      target.DeliveryPopup(command.value, command.payload, command.position);
+      break;
+
+    case EmptyPopupCommand:
+      target.EmptyPopup(command.value, command.position, command.flag);
+      break;
+
+    case VibrateCommand:
+      target.Vibrate(command.value, command.a, command.b, command.c);
+      break;
+
+    case StopVibrationCommand:
+      target.StopVibration(command.value);
+      break;
+
+    case CameraShakeCommand:
+      target.CameraShake(command.a, command.b);
+      break;
+
+    case CameraPingCommand:
+      target.CameraPing(command.position, command.value);
+      break;
+  }
+}
@@ -0,0 +1,119 @@
+// Copyright  2017 DigiPen (USA) Corporation.
+/*!
+*******************************************************************************
+\file    BufferedCharacterSink.h
+\author  James Liao
+\par     email: james.liao\@digipen.edu
+\par     Course: GAM200F17-A
+\brief   Character sink that records side effects instead of running them, so
+         worker threads can produce effects that the main thread replays
+         later in a fixed order.
+*******************************************************************************/
+
+#pragma once
+#include "CharacterSink.h"
+#include <vector>
+
+namespace fb
+{
+  class BufferedCharacterSink : public CharacterSink
+  {
+    public:
+      void Notify(int character, const evt::CharacterEvent& event, int count);
+      void Particle(CharacterParticle type, float size, glm::vec2 position, bool flipped);
+      void Squash(const std::shared_ptr<Entity>& entity, float rotation, float duration, float scale);
+      void Face(int character, bool left);
+      void DeliveryPopup(int character, int weight, glm::vec2 position);
+      void EmptyPopup(int character, glm::vec2 position, bool screenspace);
+      void Vibrate(int controller, float low, float high, float duration);
+      void StopVibration(int controller);
+      void CameraShake(float strength, float duration);
+      void CameraPing(glm::vec2 position, int weight);
+
+      /*!
+      *******************************************************************************
+      \brief   Sets the sort key for everything recorded from now on. Replay
+               puts lower keys first.
+      \param   key
+        The sort key, usually the ID of the character being updated (int).
+      \return  None (void).
+      *******************************************************************************/
+      void SetKey(int key) { key_ = key; }
+
+      /*!
+      *******************************************************************************
+      \brief   Forgets every recorded effect, keeping the memory for next time
+      \return  None (void).
+      *******************************************************************************/
+      void Clear();
+
+      /*!
+      *******************************************************************************
+      \brief   Sends the effects of several buffers to a sink, ordered by key and
+               then by the order they were recorded in, and clears the buffers.
+               The result does not depend on which buffer recorded what.
+      \param   buffers
+        The buffers to replay (BufferedCharacterSink *).
+      \param   count
+        How many buffers there are (int).
+      \param   target
+        Where to send the effects (CharacterSink &).
+      \return  None (void).
+      *******************************************************************************/
+      static void ReplayInOrder(BufferedCharacterSink* buffers, int count, CharacterSink& target);
+
+      /*!
+      *******************************************************************************
+      \brief   Sends every recorded effect to a sink grouped by type, so each
+               effects system gets all of its work in one run, and clears the
+               buffer. Particles are also grouped by emitter. Effects of the
+               same kind keep the order they were recorded in, and vibrations
+               stay in order with the stops between them.
+      \param   target
+        Where to send the effects (CharacterSink &).
+      \return  None (void).
+      *******************************************************************************/
+      void ReplayByType(CharacterSink& target);
+
+    private:
+      //! Which sink function a command replays
+      enum CommandType
+      {
+        NotifyCommand,
+        ParticleCommand,
+        SquashCommand,
+        FaceCommand,
+        DeliveryPopupCommand,
+        EmptyPopupCommand,
+        VibrateCommand,
+        StopVibrationCommand,
+        CameraShakeCommand,
+        CameraPingCommand
+      };
+
+      //! One recorded call, the meaning of each field depends on the type
+      struct Command
+      {
+        int key;            //!< Sort key set with SetKey
+        CommandType type;   //!< Which sink function to call
+        int value;          //!< Character, controller, weight or particle type
+        int payload;        //!< Index into events or entities, or a second integer
+        float a;
+        float b;
+        float c;
+        glm::vec2 position;
+        bool flag;
+      };
+
+      void Run(const Command& command, CharacterSink& target) const;
+
+      //! Which type a command is sorted with when replaying by type
+      static CommandType Group(CommandType type);
+
+      std::vector<Command> commands_;                   //!< Recorded calls, in order
+      std::vector<evt::CharacterEvent> events_;         //!< Payloads of Notify calls
+      std::vector<int> eventCounts_;                    //!< Merged copies of each payload in events_
+      std::vector<std::shared_ptr<Entity>> entities_;   //!< Targets of Squash calls
+      int key_ = 0;                                     //!< Key given to new commands
+  };
+}
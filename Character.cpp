@@ -3,44 +3,56 @@
 #include "Character.h"
 #include "PhysicsManager.h"
 #include "CharacterHandler.h"
-#include "ControllerHandler.h"
 #include "Transform.h"
 #include "EventManager.h"
-#include "MakeParticles.h"
-#include "Sprite.h"
 #include "DudeAI.h"
-#include "PopupText.h"
 #include "AdvancedBody.h"
-#include "PunchFX.h"
+#include "TargetRegistry.h"
 
-#include "ControllerHandler.h"
+using namespace glm;
 
 #define JUMP_MOD 5
 #define PUNCH_COOLDOWN 0.5f
+#define PUNCH_REACH 1.2f  // Length of a punch hitbox
+#define PUNCH_WIDTH 0.5f  // Thickness of a punch hitbox
+#define PUNCH_OFFSET 0.8f // How far out the hitbox is centered, scaled by its length
+
+// Converted once, so fixed point builds never round these again
+static const KinematicScalar wallJumpScale = ToKinematic(0.8f); // Horizontal speed kept when jumping while holding into a wall
+static const KinematicScalar knockbackScale = ToKinematic(1.5f); // Knockback speed, scaled by the max speed
+
+// Shape of the punch hitbox for each direction, indexed by Character::PunchSlot
+static const struct
+{
+  glm::vec2 dimensions;
+  glm::vec2 center;
+} punchHitboxes[] =
+{
+  { { PUNCH_REACH, PUNCH_WIDTH }, { -PUNCH_REACH * PUNCH_OFFSET, 0.0f } }, // PunchLeft
+  { { PUNCH_REACH, PUNCH_WIDTH }, { PUNCH_REACH * PUNCH_OFFSET, 0.0f } },  // PunchRight
+  { { PUNCH_WIDTH, PUNCH_REACH }, { 0.0f, PUNCH_REACH * PUNCH_OFFSET } },  // PunchUp
+  { { PUNCH_WIDTH, PUNCH_REACH }, { 0.0f, -PUNCH_REACH * PUNCH_OFFSET } }  // PunchDown
+};
 
 // If any of these values go through, something went wrong with the JSON loading
-float Character::acceleration = 0.0f;
-float Character::jumpSpeed = 0.0f;
-float Character::maxSpeed = 0.0f;
+KinematicScalar Character::acceleration = ToKinematic(0.0f);
+KinematicScalar Character::jumpSpeed = ToKinematic(0.0f);
+KinematicScalar Character::maxSpeed = ToKinematic(0.0f);
 float Character::gravity = 0.0f;
 int Character::drag = 1;
 
 Character::Character(int index)
 {
   entity_ = NULL;
-  canJump_ = false;
-  canPunch_ = false;
-  onFloor_ = true;
-  isHit_ = false;
-  terminalVelocity = false;
-  firstJump = false;
   id = index;
-  passThrough_ = false;
-  currentSlimeScore = 0;
-  slimeBagCapacity = 0;
-  zoneTimer = 1.0f;
-  punchTimer = 0.0f;
-  slimeBagCapacity = 5;
+
+  for (int i = 0; i < PunchSlotCount; ++i)
+  {
+    punchBoxes_[i] = nullptr;
+  }
+
+  // All of the character's simulation state lives in its slot of the state table
+  state().Reset(id);
 }
 
 Character::~Character()
@@ -53,358 +65,367 @@ void Character::jump(Direction direction)
 {
   // Allows the character to continue moving while in the "jumping" state
   move(direction);
+  performJump(direction);
+}
+
+void Character::performJump(Direction direction)
+{
+  CharacterStateTable& states = state();
 
   // Prevent player from jumping past the max speed
-  if (terminalVelocity)
+  if (states.HasFlag(id, TerminalVelocityFlag))
   {
     return;
   }
 
+  bool onFloor = states.HasFlag(id, OnFloorFlag);
+  bool canJump = states.HasFlag(id, CanJumpFlag);
+  bool firstJump = states.HasFlag(id, FirstJumpFlag);
+
   // Standard values to be used by all characters
-  float xSpeed = maxSpeed;
-  float ySpeed = jumpSpeed;
-  float xScale = 0.8f;
+  KinematicScalar xSpeed = maxSpeed;
+  KinematicScalar ySpeed = jumpSpeed;
+  KinematicScalar xScale = wallJumpScale;
 
-  auto body = entity_->GetComponent<cmp::AdvancedBody>();
-  vec2 newVelocity = body->GetVelocity();
+  const std::shared_ptr<cmp::AdvancedBody>& body = getBody();
+  const std::shared_ptr<cmp::Transform>& transform = getTransform();
+  KinematicVec2 newVelocity = ToKinematic(body->GetVelocity());
 
   if (direction != Down)
   {
-    if (onFloor_ || canJump_ || firstJump) { newVelocity.y = fminf(newVelocity.y + ySpeed / JUMP_MOD, ySpeed); }
+    if (onFloor || canJump || firstJump) { newVelocity.y = KinematicMin(newVelocity.y + ySpeed / JUMP_MOD, ySpeed); }
 
-    if (onFloor_ && !firstJump)
+    if (onFloor && !firstJump)
     {
       // Play the jump sound
       PlayJumpSound();
 
       // Show a jump effect
-      MakeJumpParticle(2.0f / 5.0f, entity_->GetComponent<cmp::Transform>()->GetPosition());
+      CharacterManager::GetSink().Particle(JumpParticle, 2.0f / 5.0f, transform->GetPosition());
 
-      entity_->AttachComponent(std::make_shared<PunchFX>(PunchFX(0.0f, 0.25f, 0.5f)));
+      CharacterManager::GetSink().Squash(entity_, 0.0f, 0.25f, 0.5f);
     }
     else
     {
+      // Reuses this frame's wall checks if CharacterManager has already run them
+      CharacterContacts& contacts = CharacterManager::GetContacts(id);
+      contacts.Query(*body, CONTACT_BIT(WorldLeft) | CONTACT_BIT(WorldRight), CharacterManager::GetContactArena());
+
       // Check if we're on the left wall
-      if (body->RunDetection(world, cmp::LEFT).collision)
+      if (contacts.Has(WorldLeft))
       {
         // Play the wall jump sound
         PlayWallJumpSound();
 
         // Show a jump effect
-        //MakeJumpParticle(2.0f / 5.0f, entity_->GetComponent<cmp::Transform>()->GetPosition());
+        //MakeJumpParticle(2.0f / 5.0f, transform->GetPosition());
 
         // Squish n Stretch
-        entity_->AttachComponent(std::make_shared<PunchFX>(PunchFX(0.0f, 0.25f, 0.5f)));
+        CharacterManager::GetSink().Squash(entity_, 0.0f, 0.25f, 0.5f);
 
         // Jump more vertically if the player is holding into the wall
         if (direction == Left)
         {
           newVelocity.x = xSpeed * xScale;
-          newVelocity.y = ySpeed * 1.0f;
+          newVelocity.y = ySpeed;
         }
 
         // Jump more horizontally if the player is not holding into the wall
         else
         {
           newVelocity.x = xSpeed;
-          newVelocity.y = ySpeed * 1.0f;
+          newVelocity.y = ySpeed;
         }
 
-        entity_->GetComponent<Sprite>()->SetFlipped(direction == Left);
+        face(direction == Left);
 
         // Prevent the player from double-jumping immediately off a wall
-        firstJump = false;
+        states.SetFlag(id, FirstJumpFlag, false);
       }
 
       // Check if we're on the right wall
-      else if (body->RunDetection(world, cmp::RIGHT).collision)
+      else if (contacts.Has(WorldRight))
       {
         // Play the wall jump sound
         PlayWallJumpSound();
 
         // Show a jump effect
-        //MakeJumpParticle(2.0f / 5.0f, entity_->GetComponent<cmp::Transform>()->GetPosition());
+        //MakeJumpParticle(2.0f / 5.0f, transform->GetPosition());
 
         // Squish n Stretch
-        entity_->AttachComponent(std::make_shared<PunchFX>(PunchFX(0.0f, 0.25f, 0.5f)));
+        CharacterManager::GetSink().Squash(entity_, 0.0f, 0.25f, 0.5f);
 
         // Jump more vertically if the player is holding into the wall
         if (direction == Right)
         {
           newVelocity.x = -xSpeed * xScale;
-          newVelocity.y = ySpeed * 1.0f;
+          newVelocity.y = ySpeed;
         }
         // Jump more horizontally if the player is not holding into the wall
         else
         {
           newVelocity.x = -xSpeed;
-          newVelocity.y = ySpeed * 1.0f;
+          newVelocity.y = ySpeed;
         }
 
-        entity_->GetComponent<Sprite>()->SetFlipped(direction != Right);
+        face(direction != Right);
 
         // Prevent the player from double-jumping immediately off a wall
-        firstJump = false;
+        states.SetFlag(id, FirstJumpFlag, false);
       }
-      else if (canJump_ && firstJump)
+      else if (canJump && firstJump)
       {
         // Play the double jump sound
         PlayDoubleJumpSound();
 
         // Show a jump effect
 
-        auto trans = entity_->GetComponent<cmp::Transform>();
+        vec2 pos = transform->GetPosition() - vec2(0, (transform->GetScale().y / 2.0f));
 
-        vec2 pos = trans->GetPosition() - vec2(0, (trans->GetScale().y / 2.0f));
-
-        MakeDoubleJumpParticle(2.5f, pos, !entity_->GetComponent<Sprite>()->IsFlipped());
+        CharacterManager::GetSink().Particle(DoubleJumpParticle, 2.5f, pos, !isFacingLeft());
         
-        entity_->AttachComponent(std::make_shared<PunchFX>(PunchFX(0.0f, 0.25f, 0.5f)));
+        CharacterManager::GetSink().Squash(entity_, 0.0f, 0.25f, 0.5f);
 
-        newVelocity.y = fmaxf(newVelocity.y, ySpeed / JUMP_MOD);
-        newVelocity.y = fminf(newVelocity.y + ySpeed / JUMP_MOD, ySpeed);
+        newVelocity.y = KinematicMax(newVelocity.y, ySpeed / JUMP_MOD);
+        newVelocity.y = KinematicMin(newVelocity.y + ySpeed / JUMP_MOD, ySpeed);
 
-        canJump_ = false;
+        states.SetFlag(id, CanJumpFlag, false);
       }
     }
   }
   else
   {
     //Jump down
-    this->passThrough_ = true;
+    states.SetFlag(id, PassThroughFlag, true);
 
     //Prevents the player from double-jumping mid fall-through until they release the button
-    terminalVelocity = true;
+    states.SetFlag(id, TerminalVelocityFlag, true);
   }
 
   if (newVelocity.y >= ySpeed)
   {
-    terminalVelocity = true;
+    states.SetFlag(id, TerminalVelocityFlag, true);
   }
 
-  body->SetVelocity(newVelocity);
+  body->SetVelocity(ToFloat(newVelocity));
 }
 
 void Character::basicAttack(Direction direction)
 {
   move(direction);
+  performBasicAttack(direction);
+}
 
+void Character::performBasicAttack(Direction direction)
+{
   // Do nothing if the punch is still on cooldown
-  if (punchTimer > 0)
+  if (state().punchTimer[id] > 0)
   {
     return;
   }
 
   ResetPunchTimer();
 
-  // Setup a temporary hitbox
-  CollisionLayer hitLayer(base, user | king);
-  BoxCollider* hitBox;
-  CollisionResult result;
-  auto transform = entity_->GetComponent<cmp::Transform>();
+  const std::shared_ptr<cmp::Transform>& transform = getTransform();
 
-  hitBox = PhysicsManager::GetBoxCollider();
-  hitBox->SetParent(entity_);
-  hitBox->SetLayer(hitLayer);
-  hitBox->SetBound(false);
+//        evt::CharacterEvent charEvent;
+//    charEvent.characterEntity = entity_;
+//    charEvent.type = evt::punch;
+ 
+  if (!isFacingLeft())
+    CharacterManager::GetSink().Particle(PunchParticle, 5.0f, transform->GetPosition() + glm::vec2(0.5f * transform->GetScale().x, 0.0f));
+  else
+    CharacterManager::GetSink().Particle(PunchParticle, 5.0f, transform->GetPosition() - glm::vec2(0.5f * transform->GetScale().x, 0.0f));
+
+  // Hits are resolved together with everyone else's punches in CharacterManager::Update
+  CharacterManager::QueuePunch(id, direction);
+}
 
-  float hitBoxSize = 1.2f;
-  float posScale = 0.8f;
+ContactSpan Character::queryPunch(Direction direction, ContactArena& arena)
+{
+  // Pick the hitbox for the direction the player wants to punch
+  BoxCollider* hitBox;
 
-  // Set the hitbox center depending on where the player wants to punch
   switch (direction)
   {
     case Left:
-      hitBox->SetDimensions({ hitBoxSize, 0.5f });
-      hitBox->SetCenter({ -hitBoxSize * posScale, 0.0f });
+      hitBox = punchBoxes_[PunchLeft];
       break;
 
     case Right:
-      hitBox->SetDimensions({ hitBoxSize, 0.5f });
-      hitBox->SetCenter({ hitBoxSize * posScale, 0.0f });
+      hitBox = punchBoxes_[PunchRight];
       break;
 
     case Up:
-      hitBox->SetDimensions({ 0.5f, hitBoxSize });
-      hitBox->SetCenter({ 0.0f, hitBoxSize * posScale });
+      hitBox = punchBoxes_[PunchUp];
       break;
 
     case Down:
-      hitBox->SetDimensions({ 0.5f, hitBoxSize });
-      hitBox->SetCenter({ 0.0f, -hitBoxSize  * posScale });
+      hitBox = punchBoxes_[PunchDown];
       break;
 
     default:
-      if (entity_->GetComponent<Sprite>()->IsFlipped())
-      {
-        hitBox->SetDimensions({ hitBoxSize, 0.5f });
-        hitBox->SetCenter({ -hitBoxSize * posScale, 0.0f });
-      }
-      else
-      {
-        hitBox->SetDimensions({ hitBoxSize, 0.5f });
-        hitBox->SetCenter({ hitBoxSize * posScale, 0.0f });
-      }
+      hitBox = punchBoxes_[isFacingLeft() ? PunchLeft : PunchRight];
   }
 
-//        evt::CharacterEvent charEvent;
-//    charEvent.characterEntity = entity_;
-//    charEvent.type = evt::punch;
- 
-  if (!entity_->GetComponent<Sprite>()->IsFlipped())
-    MakePunchParticle(5.0f, transform->GetPosition() + glm::vec2(0.5f * transform->GetScale().x, 0.0f));
-  else
-    MakePunchParticle(5.0f, transform->GetPosition() - glm::vec2(0.5f * transform->GetScale().x, 0.0f));
-    
-
   // Check if the hitbox hits anything
-  result = PhysicsManager::RunCollision(*hitBox);
-  if (result.collision)
+  return arena.Store(PhysicsManager::RunCollision(*hitBox));
+}
+
+void Character::resolvePunch(Direction direction, const ContactSpan& hits)
+{
+  if (hits.empty())
+  {
+    PlayPunchMissSound();
+    return;
+  }
+
+  for (const BoxCollider* collider : hits)
   {
-    // boxCollisions is an array of 5 BoxColliders, there's probably a less magical way of doing this
-    for (int i = 0; i < 5; i++)
+    std::shared_ptr<Entity> entity = collider->GetParent().lock();
+
+    if (entity != nullptr)
     {
-      const BoxCollider* collider = result.boxCollisions[i];
+      // Find out what we hit with a single lookup
+      TargetInfo target = TargetRegistry::Find(entity.get());
 
-      // If a collider exists, do stuff
-      if (collider)
+      // The giant is spawned by DudeAI, so it may not have been registered
+      if (target.category == TargetNone && entity->GetName() == "aliengiant")
       {
-        std::shared_ptr<Entity> entity = collider->GetParent().lock();
+        target.category = TargetGiant;
+      }
 
-        if (entity != nullptr)
+      if (target.category == TargetCharacter && target.index != id)
+      {
+        int charID = target.index;
+
+        // Get the Transform of the character so we can see its position
+        vec2 position = CharacterManager::GetCharacter(charID)->getTransform()->GetPosition();
+
+        // Prevent the fighter from perma-stunning players to a degree
+        if (CharacterManager::GetCharacter(charID)->canMove())
         {
-          // Get the Transform of the entity so we can see its position
-          vec2 position = entity->GetComponent<cmp::Transform>()->GetPosition();
+          // Play the punch sound
+          PlayPunchHitSound();
+          CharacterSink& sink = CharacterManager::GetSink();
+          sink.CameraShake(0.05f, 0.015f);
+          sink.Vibrate(charID, 0.5f, 1.0f, 0.2f);
+          sink.Vibrate(id, 0.5f, 1.0f, 0.2f);
 
-          int charID = 5;
+          // Knockback speeds
+          KinematicScalar xSpeed = maxSpeed * knockbackScale;
+          KinematicScalar ySpeed = jumpSpeed / 2;
 
-          // Get the ID of the character we're hitting (there should be a better way to do this)
-          if (entity->GetName() == "Player 0" && id != 0)
-          {
-            charID = 0;
-          }
-          else if (entity->GetName() == "Player 1" && id != 1)
-          {
-            charID = 1;
-          }
-          else if (entity->GetName() == "Player 2" && id != 2)
-          {
-            charID = 2;
-          }
-          else if (entity->GetName() == "Player 3" && id != 3)
-          {
-            charID = 3;
-          }
-          else if (entity->GetName() == "aliengiant")
-          {
-            charID = 4;
-          }
+          const std::shared_ptr<cmp::AdvancedBody>& body = CharacterManager::GetCharacter(charID)->getBody();
 
-          if (charID < 4)
+          // Push characters based on which direction we're hitting
+          switch (direction)
           {
-            // Prevent the fighter from perma-stunning players to a degree
-            if (CharacterManager::GetCharacter(charID)->canMove())
-            {
-              // Play the punch sound
-              PlayPunchHitSound();
-              CamManager::CamShake::Set(0.05f, 0.015f);
-              ControllerManager::GetController(charID)->VibrateController(0.5f, 1.0f, 0.2f);
-              ControllerManager::GetController(id)->VibrateController(0.5f, 1.0f, 0.2f);
-
-              // Knockback speeds
-              float xSpeed = maxSpeed * 1.5f;
-              float ySpeed = jumpSpeed / 2;
-
-              auto body = entity->GetComponent<cmp::AdvancedBody>();
-
-              // Push characters based on which direction we're hitting
-              switch (direction)
-              {
-              case Right:
-                body->SetVelocity({ xSpeed, ySpeed });
-                break;
-
-              case Left:
-                body->SetVelocity({ -xSpeed, ySpeed });
-                break;
-
-              default:
-                // If the entity is to the right of us, push the entity to the right
-                if (position.x > entity_->GetComponent<cmp::Transform>()->GetPosition().x)
-                {
-                  body->SetVelocity({ xSpeed, ySpeed });
-                }
-
-                // Otherwise, push the entity to the left
-                else
-                {
-                  body->SetVelocity({ -xSpeed, ySpeed });
-                }
-              }
-
-              body->GetParent().lock()->AttachComponent(std::make_shared<PunchFX>(PunchFX(10.0f, 0.25f, 0.5f)));
-            }
+          case Right:
+            body->SetVelocity(ToFloat(KinematicVec2(xSpeed, ySpeed)));
+            break;
 
-            Character* player = CharacterManager::GetCharacter(charID);
-            // Set that the character has been hit
-            player->setHit(true);
+          case Left:
+            body->SetVelocity(ToFloat(KinematicVec2(-xSpeed, ySpeed)));
+            break;
 
-            // Dropping slimes go here
-            bool superPunch = false;
-            int max = 2;
-            if (superPunch)
-              max = 5;
+          default:
+            // If the entity is to the right of us, push the entity to the right
+            if (position.x > getTransform()->GetPosition().x)
+            {
+              body->SetVelocity(ToFloat(KinematicVec2(xSpeed, ySpeed)));
+            }
 
-            for (int i = 0; i < max; i++)
+            // Otherwise, push the entity to the left
+            else
             {
-              int weight = 0;
-              weight = player->popSlime();
-              glm::vec2 position = player->getEntity()->GetComponent<fb::cmp::Transform>()->GetPosition();
-
-              if (weight == 5)
-              {
-                DudeAI::dropSlime(position, SLIMEGOLDEN, "CharacterTrail" + std::to_string(player->id + 1));
-              }
-              else if (weight == 1)
-              {
-                DudeAI::dropSlime(position, SLIMENORMAL, "CharacterTrail" + std::to_string(player->id + 1));
-             }
-             
+              body->SetVelocity(ToFloat(KinematicVec2(-xSpeed, ySpeed)));
             }
           }
 
-          //Punched big slime
-          else if (charID == 4)
-          {
-            // Play the punch sound
-            PlayPunchHitSound();
+          CharacterManager::GetSink().Squash(entity, 10.0f, 0.25f, 0.5f);
+        }
 
-            // Vibrate the controller
-            ControllerManager::GetController(id)->VibrateController(0.5f, 1.0f, 0.2f);
-            CamManager::CamShake::Set(0.05f, 0.015f);
+        Character* player = CharacterManager::GetCharacter(charID);
+        // Set that the character has been hit
+        player->setHit(true);
 
-            //Shoot a slime to the players feet
-            glm::vec2 playerPosition = getEntity()->GetComponent<fb::cmp::Transform>()->GetPosition();
-            glm::vec2 entityPosition = entity->GetComponent<fb::cmp::Transform>()->GetPosition();
-            glm::vec2 force = playerPosition - entityPosition;
+        // Dropping slimes go here
+        bool superPunch = false;
+        int max = 2;
+        if (superPunch)
+          max = 5;
 
-            DudeAI::DamageDude(entity, 2, force);
-          }
-          else
+        for (int i = 0; i < max; i++)
+        {
+          int weight = 0;
+          weight = player->popSlime();
+          glm::vec2 position = player->getTransform()->GetPosition();
+
+          if (weight == SLIME_GOLDEN_WEIGHT)
           {
-            PlayPunchMissSound();
+            DudeAI::dropSlime(position, SLIMEGOLDEN, CharacterManager::GetTrailName(player->id));
           }
+          else if (weight == SLIME_NORMAL_WEIGHT)
+          {
+            DudeAI::dropSlime(position, SLIMENORMAL, CharacterManager::GetTrailName(player->id));
+         }
+         
         }
       }
+
+      //Punched big slime
+      else if (target.category == TargetGiant)
+      {
+        // Play the punch sound
+        PlayPunchHitSound();
+
+        // Vibrate the controller
+        CharacterManager::GetSink().Vibrate(id, 0.5f, 1.0f, 0.2f);
+        CharacterManager::GetSink().CameraShake(0.05f, 0.015f);
+
+        //Shoot a slime to the players feet
+        glm::vec2 playerPosition = getTransform()->GetPosition();
+        glm::vec2 entityPosition = entity->GetComponent<fb::cmp::Transform>()->GetPosition();
+        glm::vec2 force = playerPosition - entityPosition;
+
+        DudeAI::DamageDude(entity, 2, force);
+      }
+      else
+      {
+        PlayPunchMissSound();
+      }
     }
   }
-  else
+}
+
+void Character::resolveIntent(const CharacterIntent& intent)
+{
+  // One velocity update for the frame, whichever buttons were pressed
+  if (intent.move)
   {
-    PlayPunchMissSound();
+    move(static_cast<Direction>(intent.moveDirection));
+  }
+
+  if (intent.jump)
+  {
+    performJump(static_cast<Direction>(intent.jumpDirection));
+  }
+
+  if (intent.attack)
+  {
+    performBasicAttack(static_cast<Direction>(intent.attackDirection));
+  }
+
+  if (intent.special)
+  {
+    specialAttack(static_cast<Direction>(intent.specialDirection));
   }
 
-  // Return the hit box collider once we're done with it
-  PhysicsManager::FreeBoxCollider(hitBox->GetID());
+  if (intent.block)
+  {
+    block();
+  }
 }
 
 void Character::specialAttack(Direction direction)
@@ -420,19 +441,17 @@ void Character::block()
 void Character::move(Direction direction)
 {
   // Get the character's current velocity
-  auto body = entity_->GetComponent<cmp::AdvancedBody>();
-  vec2 newVelocity = body->GetVelocity();
-
-  // Get the character's sprite
-  std::shared_ptr<Sprite> sprite = entity_->GetComponent<Sprite>();
+  const std::shared_ptr<cmp::AdvancedBody>& body = getBody();
+  KinematicVec2 newVelocity = ToKinematic(body->GetVelocity());
 
   // standard values to be used recurringly in the function
-  float dSpeed = acceleration;
-  float topSpeed = maxSpeed;
+  KinematicScalar dSpeed = acceleration;
+  KinematicScalar topSpeed = maxSpeed;
+  bool onFloor = state().HasFlag(id, OnFloorFlag);
 
   if (direction != Down)
   {
-    passThrough_ = false;
+    state().SetFlag(id, PassThroughFlag, false);
   }
 
   switch (direction)
@@ -440,7 +459,7 @@ void Character::move(Direction direction)
     // Move left
     case Left:
       // If the character is on the floor, move normally
-      if (onFloor_)
+      if (onFloor)
       {
         newVelocity.x -= dSpeed;
       }
@@ -452,18 +471,17 @@ void Character::move(Direction direction)
       }
 
       // Sprite is now facing left
-      if (sprite)
-        sprite->SetFlipped(true);
+      face(true);
 
       //Clamp the velocity
-      newVelocity.x = fmaxf(newVelocity.x, -topSpeed);
+      newVelocity.x = KinematicMax(newVelocity.x, -topSpeed);
 
       break;
 
     // Move right
     case Right:
       // If the character is on the floor, move normally
-      if (onFloor_)
+      if (onFloor)
       {
         newVelocity.x += dSpeed;
       }
@@ -475,29 +493,75 @@ void Character::move(Direction direction)
       }
 
       // Sprite is now facing right
-      if (sprite)
-        sprite->SetFlipped(false);
+      face(false);
 
       //Clamp the velocity
-      newVelocity.x = fminf(newVelocity.x, topSpeed);
+      newVelocity.x = KinematicMin(newVelocity.x, topSpeed);
 
       break;
 
     // Center, don't move
     default:
-      if (onFloor_)
+      if (onFloor)
       {
-        newVelocity.x = 0.0f;
+        newVelocity.x = ToKinematic(0.0f);
       }
   }
 
   // Set the character's updated velocity
-  body->SetVelocity(newVelocity);
+  body->SetVelocity(ToFloat(newVelocity));
 }
 
 void Character::attachEntity(std::shared_ptr<fb::Entity> entity)
 {
   entity_ = entity;
+
+  // The handles share the entity's lifetime, so they are only looked up when the entity changes
+  transform_ = entity_ ? entity_->GetComponent<cmp::Transform>() : nullptr;
+  body_ = entity_ ? entity_->GetComponent<cmp::AdvancedBody>() : nullptr;
+#ifndef FB_HEADLESS
+  sprite_ = entity_ ? entity_->GetComponent<Sprite>() : nullptr;
+#endif
+
+  // The punch hitboxes follow the character to its new entity
+  for (int i = 0; i < PunchSlotCount; ++i)
+  {
+    if (punchBoxes_[i])
+    {
+      punchBoxes_[i]->SetParent(entity_);
+    }
+  }
+}
+
+void Character::createPunchHitboxes()
+{
+  // Punch hitboxes sit on the base layer, so only our own RunCollision queries ever see them
+  CollisionLayer hitLayer(base, user | king);
+
+  for (int i = 0; i < PunchSlotCount; ++i)
+  {
+    // Kept out of the physics pool, so the engine neither steps them nor runs out of colliders for them
+    BoxCollider* hitBox = new BoxCollider();
+    hitBox->SetParent(entity_);
+    hitBox->SetLayer(hitLayer);
+    hitBox->SetBound(false);
+    hitBox->SetDimensions(punchHitboxes[i].dimensions);
+    hitBox->SetCenter(punchHitboxes[i].center);
+
+    punchBoxes_[i] = hitBox;
+  }
+}
+
+void Character::destroyPunchHitboxes()
+{
+  for (int i = 0; i < PunchSlotCount; ++i)
+  {
+    if (punchBoxes_[i])
+    {
+      delete punchBoxes_[i];
+      punchBoxes_[i] = nullptr;
+    }
+  }
 }
 
 std::shared_ptr<Entity> Character::getEntity()
@@ -505,34 +569,41 @@ std::shared_ptr<Entity> Character::getEntity()
   return entity_;
 }
 
+#ifndef FB_HEADLESS
+void Character::attachFist(std::shared_ptr<cmp::FistComponent> fist)
+{
+  fist_ = fist;
+}
+#endif
+
 bool Character::canJump()
 {
-  return canJump_;
+  return state().HasFlag(id, CanJumpFlag);
 }
 
 bool Character::isOnFloor()
 {
-  return onFloor_;
+  return state().HasFlag(id, OnFloorFlag);
 }
 
 bool Character::isFirstJump()
 {
-  return firstJump;
+  return state().HasFlag(id, FirstJumpFlag);
 }
 
 bool Character::canMove()
 {
-  return !isHit_;
+  return !state().HasFlag(id, IsHitFlag);
 }
 
 void Character::removeLimiter()
 {
-  terminalVelocity = false;
+  state().SetFlag(id, TerminalVelocityFlag, false);
 }
 
 void Character::addLimiter()
 {
-  terminalVelocity = true;
+  state().SetFlag(id, TerminalVelocityFlag, true);
 }
 
 int Character::GetID()
@@ -542,37 +613,64 @@ int Character::GetID()
 
 void Character::setOnFloor(bool floor)
 {
-  onFloor_ = floor;
+  state().SetFlag(id, OnFloorFlag, floor);
 }
 
 void Character::setJump(bool jump)
 {
-  canJump_ = jump;
+  state().SetFlag(id, CanJumpFlag, jump);
 }
 
 void Character::setFirstJump(bool first)
 {
-  firstJump = first;
+  state().SetFlag(id, FirstJumpFlag, first);
 }
 
 void Character::setHit(bool gotHit)
 {
-  isHit_ = gotHit;
+  state().SetFlag(id, IsHitFlag, gotHit);
+}
+
+bool Character::canPassThrough()
+{
+  return state().HasFlag(id, PassThroughFlag);
+}
+
+void Character::setPassThrough(bool pass)
+{
+  state().SetFlag(id, PassThroughFlag, pass);
+}
+
+bool Character::isFacingLeft()
+{
+  return state().HasFlag(id, FacingLeftFlag);
+}
+
+void Character::face(bool left)
+{
+  // The flag is the source of truth, the sprite just follows it
+  if (state().HasFlag(id, FacingLeftFlag) == left)
+  {
+    return;
+  }
+
+  state().SetFlag(id, FacingLeftFlag, left);
+  CharacterManager::GetSink().Face(id, left);
 }
 
 float Character::GetAcceleration()
 {
-  return acceleration;
+  return ToFloat(acceleration);
 }
 
 float Character::GetJumpSpeed()
 {
-  return jumpSpeed;
+  return ToFloat(jumpSpeed);
 }
 
 float Character::GetMaxSpeed()
 {
-  return maxSpeed;
+  return ToFloat(maxSpeed);
 }
 
 float Character::GetGravity()
@@ -587,17 +685,17 @@ int Character::GetDrag()
 
 void Character::SetAcceleration(float speed)
 {
-  acceleration = speed;
+  acceleration = ToKinematic(speed);
 }
 
 void Character::SetJumpSpeed(float speed)
 {
-  jumpSpeed = speed;
+  jumpSpeed = ToKinematic(speed);
 }
 
 void Character::SetMaxSpeed(float speed)
 {
-  maxSpeed = speed;
+  maxSpeed = ToKinematic(speed);
 }
 
 void Character::SetGravity(float grav)
@@ -612,115 +710,87 @@ void Character::SetDrag(int resistance)
 
 float Character::GetPunchTimer()
 {
-  return punchTimer;
+  return state().punchTimer[id];
 }
 
 void Character::TickPunchTimer(float dt)
 {
-  punchTimer -= dt;
+  state().punchTimer[id] -= dt;
 }
 
 void Character::ResetPunchTimer()
 {
-  punchTimer = PUNCH_COOLDOWN;
+  state().punchTimer[id] = PUNCH_COOLDOWN;
 }
 
 int Character::getSlimeBagWeight()
 {
-  return currentSlimeScore;
+  return state().slimeBag[id].Weight();
 }
 
 float Character::getZoneTimer()
 {
-  return zoneTimer;
+  return state().zoneTimer[id];
 }
 
 void Character::tickZoneTimer(float dt)
 {
-  zoneTimer -= dt;
+  state().zoneTimer[id] -= dt;
 }
 
 void Character::setZoneTimer(float time)
 {
-  zoneTimer = time;
+  state().zoneTimer[id] = time;
 }
 
 int Character::getSlimeBagCapacity()
 {
-  return slimeBagCapacity;
+  return state().slimeBag[id].capacity;
 }
 
-const std::vector<int>& Character::getSlimeBag()
+const SlimeBag& Character::getSlimeBag()
 {
-  return slimeBag;
+  return state().slimeBag[id];
 }
 
 int Character::addSlime(int weight)
 {
-  if (slimeBagSize + 1 <= slimeBagCapacity)
-  {
-    slimeBagSize += 1;
-    currentSlimeScore += weight;
-    slimeBag.push_back(weight);
+  SlimeBag& slimeBag = state().slimeBag[id];
 
-    if (weight > 1)
-      std::sort(slimeBag.begin(), slimeBag.end(), std::greater_equal<int>());
+  if (slimeBag.Add(weight))
+  {
     PlaySlimePickupSound();
     return 0;
   }
-  else
-  {
-    if (weight == 5 && slimeBag.back() == 1)
-    {
-      slimeBag.pop_back();
-      currentSlimeScore -= 1;
-
-      slimeBag.push_back(weight);
-      currentSlimeScore += 5;
 
-      std::sort(slimeBag.begin(), slimeBag.end(), std::greater_equal<int>());
-      return 1;
-    }
-    else
-      PlaySlimeFullSound();
-      return weight;
+  // A golden slime can still be picked up by dropping a normal one
+  if (weight == SLIME_GOLDEN_WEIGHT && slimeBag.SwapInGolden())
+  {
+    return SLIME_NORMAL_WEIGHT;
   }
+
+  PlaySlimeFullSound();
+  return weight;
 }
 
 void Character::clearSlimeBagWeight()
 {
-  currentSlimeScore = 0;
-  slimeBagSize = 0;
-  slimeBag.clear();
+  state().slimeBag[id].Clear();
 }
 
 void Character::removeSlime(int weight)
 {
-  for (unsigned i = 0; i < slimeBag.size(); ++i)
-  {
-    if (slimeBag[i] == weight)
-    {
-      slimeBagSize -= 1;
-      slimeBag[i] = 0;
-      currentSlimeScore -= weight;
-      return;
-    }
-  }
+  state().slimeBag[id].Remove(weight);
 }
 
 int Character::popSlime()
 {
-  int result = 0;
-  if (currentSlimeScore)
-    result = slimeBag.back();
-  currentSlimeScore -= result;
-  if (result)
-  {
-    slimeBag.pop_back();
-    slimeBagSize -= 1;
-  }
+  return state().slimeBag[id].Pop();
+}
 
-  return result;
+CharacterStateTable& Character::state()
+{
+  return CharacterManager::GetStateTable();
 }
 
 void Character::PlayJumpSound()
@@ -728,7 +798,7 @@ void Character::PlayJumpSound()
   evt::CharacterEvent jumpEvent;
   jumpEvent.type = evt::jump;
   jumpEvent.characterEntity = entity_;
-  evt::EventManager::GetCharacterEventSubject().Notify(jumpEvent);
+  CharacterManager::QueueEvent(id, jumpEvent);
 }
 
 void Character::PlayDoubleJumpSound()
@@ -736,7 +806,7 @@ void Character::PlayDoubleJumpSound()
   evt::CharacterEvent jumpEvent;
   jumpEvent.type = evt::doubleJump;
   jumpEvent.characterEntity = entity_;
-  evt::EventManager::GetCharacterEventSubject().Notify(jumpEvent);
+  CharacterManager::QueueEvent(id, jumpEvent);
 }
 
 void Character::PlayWallJumpSound()
@@ -744,7 +814,7 @@ void Character::PlayWallJumpSound()
   evt::CharacterEvent jumpEvent;
   jumpEvent.type = evt::wallJump;
   jumpEvent.characterEntity = entity_;
-  evt::EventManager::GetCharacterEventSubject().Notify(jumpEvent);
+  CharacterManager::QueueEvent(id, jumpEvent);
 }
 
 void Character::PlayPunchHitSound()
@@ -752,7 +822,7 @@ void Character::PlayPunchHitSound()
   evt::CharacterEvent punchEvent;
   punchEvent.type = evt::punchHit;
   punchEvent.characterEntity = entity_;
-  evt::EventManager::GetCharacterEventSubject().Notify(punchEvent);
+  CharacterManager::QueueEvent(id, punchEvent);
 }
 
 void Character::PlayPunchMissSound()
@@ -760,7 +830,7 @@ void Character::PlayPunchMissSound()
   evt::CharacterEvent punchEvent;
   punchEvent.type = evt::punchMiss;
   punchEvent.characterEntity = entity_;
-  evt::EventManager::GetCharacterEventSubject().Notify(punchEvent);
+  CharacterManager::QueueEvent(id, punchEvent);
 }
 
 void Character::PlaySlimePickupSound()
@@ -768,7 +838,7 @@ void Character::PlaySlimePickupSound()
   evt::CharacterEvent punchEvent;
   punchEvent.type = evt::slimePickup;
   punchEvent.characterEntity = entity_;
-  evt::EventManager::GetCharacterEventSubject().Notify(punchEvent);
+  CharacterManager::QueueEvent(id, punchEvent);
 }
 
 void Character::PlaySlimeFullSound()
@@ -776,7 +846,7 @@ void Character::PlaySlimeFullSound()
   evt::CharacterEvent punchEvent;
   punchEvent.type = evt::slimeFull;
   punchEvent.characterEntity = entity_;
-  evt::EventManager::GetCharacterEventSubject().Notify(punchEvent);
+  CharacterManager::QueueEvent(id, punchEvent);
 }
 
 void Character::PlayMoveSound()
@@ -784,5 +854,5 @@ void Character::PlayMoveSound()
   evt::CharacterEvent moveEvent;
   moveEvent.type = evt::jump;
   moveEvent.characterEntity = entity_;
-  evt::EventManager::GetCharacterEventSubject().Notify(moveEvent);
+  CharacterManager::QueueEvent(id, moveEvent);
 }
@@ -12,16 +12,35 @@
 #include "Entity.h"
 #include "Collider.h"
 #include "CollisionLayer.h"
-#include "Fist.h"
+#include "Transform.h"
+#include "AdvancedBody.h"
+#include "Direction.h"
+#include "CharacterState.h"
+#include "ContactArena.h"
+#include "InputCommand.h"
+#include "Kinematics.h"
 #include <set>
 
-using namespace fb;
+#ifndef FB_HEADLESS
+#include "Sprite.h"
+#include "FistComponent.h"
+#endif
 
-enum Direction;
+using namespace fb;
 
 class Character
 {
   public:
+    //! Which punch hitbox to use, one per punch direction
+    enum PunchSlot
+    {
+      PunchLeft,
+      PunchRight,
+      PunchUp,
+      PunchDown,
+      PunchSlotCount
+    };
+
     /*!
     *******************************************************************************
     \brief  Constructor
@@ -52,6 +71,39 @@ class Character
     *******************************************************************************/
     void basicAttack(Direction direction);
 
+    /*!
+    *******************************************************************************
+    \brief   Runs the punch hitbox for a direction against the world. Called for
+             every queued punch before any of them are resolved.
+    \param   direction
+      The direction the attack was performed in (Direction).
+    \param   arena
+      Where to keep the colliders that were hit (ContactArena &).
+    \return  Every collider the punch hit (ContactSpan).
+    *******************************************************************************/
+    ContactSpan queryPunch(Direction direction, ContactArena& arena);
+
+    /*!
+    *******************************************************************************
+    \brief   Acts on everything the character was asked to do this frame. Movement
+             is resolved once, however many buttons were pressed.
+    \param   intent
+      The frame's folded inputs (const CharacterIntent &).
+    \return  None (void).
+    *******************************************************************************/
+    void resolveIntent(const CharacterIntent& intent);
+
+    /*!
+    *******************************************************************************
+    \brief   Applies knockback, stuns, slime drops and effects for a punch
+    \param   direction
+      The direction the attack was performed in (Direction).
+    \param   hits
+      Every collider the punch hit, from queryPunch (const ContactSpan &).
+    \return  None (void).
+    *******************************************************************************/
+    void resolvePunch(Direction direction, const ContactSpan& hits);
+
     /*!
     *******************************************************************************
     \brief   Virtual function for how the character should perform a special attack
@@ -79,7 +131,9 @@ class Character
 
     /*!
     *******************************************************************************
-    \brief   Attach an entity to the character
+    \brief   Attach an entity to the character, and look up the components the
+             character keeps handles to. The handles are held until the next
+             attach, so call it again if one of those components is replaced.
     \param   entity
       Pointer to the entity this character will be responsible for (shared_ptr<fb::Entity>).
     \return  None (void).
@@ -92,6 +146,41 @@ class Character
     \return  The attached entity (shared_ptr<Entity>).
     *******************************************************************************/
     std::shared_ptr<Entity> getEntity();
+
+#ifndef FB_HEADLESS
+    /*!
+    *******************************************************************************
+    \brief   Attach the fist that follows this character around
+    \param   fist
+      The fist component of the character's fist entity (shared_ptr<cmp::FistComponent>).
+    \return  None (void).
+    *******************************************************************************/
+    void attachFist(std::shared_ptr<cmp::FistComponent> fist);
+#endif
+
+    /*!
+    *******************************************************************************
+    \brief   Makes one hitbox per punch direction and sets it up on the attached
+             entity. The hitboxes are owned by the character rather than taken
+             from the physics pool, so the engine never steps them. They are
+             kept until destroyPunchHitboxes, and only queried while punching.
+    \return  None (void).
+    *******************************************************************************/
+    void createPunchHitboxes();
+
+    /*!
+    *******************************************************************************
+    \brief   Deletes the punch hitboxes
+    \return  None (void).
+    *******************************************************************************/
+    void destroyPunchHitboxes();
+
+    const std::shared_ptr<cmp::Transform>& getTransform() { return transform_; }         //!< Cached Transform of the attached entity
+    const std::shared_ptr<cmp::AdvancedBody>& getBody() { return body_; }                //!< Cached AdvancedBody of the attached entity
+#ifndef FB_HEADLESS
+    const std::shared_ptr<Sprite>& getSprite() { return sprite_; }                       //!< Cached Sprite of the attached entity
+    const std::shared_ptr<cmp::FistComponent>& getFist() { return fist_; }               //!< Cached FistComponent of the character's fist
+#endif
    
     /*!
     *******************************************************************************
@@ -291,7 +380,7 @@ class Character
 
     int getSlimeBagCapacity();
 
-    const std::vector<int> & getSlimeBag();
+    const SlimeBag& getSlimeBag();
 
     int addSlime(int weight);
 
@@ -301,9 +390,48 @@ class Character
 
     int popSlime();
 
-    bool passThrough_; //!< Is the player able to pass through passable platforms?
+    /*!
+    *******************************************************************************
+    \brief   Return whether or not the character can pass through passable platforms
+    \return  True if the character can pass through, False otherwise (bool).
+    *******************************************************************************/
+    bool canPassThrough();
+
+    /*!
+    *******************************************************************************
+    \brief   Set the character's passThrough flag
+    \param   pass
+      Whether or not the character can pass through passable platforms (bool).
+    \return  None (void).
+    *******************************************************************************/
+    void setPassThrough(bool pass);
+
+    /*!
+    *******************************************************************************
+    \brief   Return whether or not the character is facing left
+    \return  True if the character is facing left, False otherwise (bool).
+    *******************************************************************************/
+    bool isFacingLeft();
 
   private:
+    /*!
+    *******************************************************************************
+    \brief   The jump itself, without the movement update
+    \param   direction
+      The direction held while jumping (Direction).
+    \return  None (void).
+    *******************************************************************************/
+    void performJump(Direction direction);
+
+    /*!
+    *******************************************************************************
+    \brief   The basic attack itself, without the movement update
+    \param   direction
+      The direction the attack should be performed in (Direction).
+    \return  None (void).
+    *******************************************************************************/
+    void performBasicAttack(Direction direction);
+
     /*!
     *******************************************************************************
     \brief   Play a jump sound
@@ -347,25 +475,35 @@ class Character
     *******************************************************************************/
     void PlayMoveSound();
 
-    std::shared_ptr<Entity> entity_; //!< The entity the character should be acting upon
+    /*!
+    *******************************************************************************
+    \brief   Returns the state table this character is a view into
+    \return  The shared character state table (CharacterStateTable &).
+    *******************************************************************************/
+    static CharacterStateTable& state();
+
+    /*!
+    *******************************************************************************
+    \brief   Turns the character, and tells the sink so the sprite can follow
+    \param   left
+      Whether the character should face left (bool).
+    \return  None (void).
+    *******************************************************************************/
+    void face(bool left);
 
-    bool canJump_; //!< Whether or not the player can double jump
-    bool canPunch_; //!< Whether or not the player can punch
-    bool onFloor_; //!< Whether or not the player is standing on a platform
-    bool isHit_; //!< Whether or not the player has been hit (with a punch)
-    bool terminalVelocity; //!< Whether or not the player has reached the maximum jump speed
-    bool firstJump; //!< Whether or not the player has jumped once
-    int id; //!< The character's ID
-    int slimeBagCapacity; //!< How many slimes the character can hold.
-    int slimeBagSize; //!< How many slimes the character is holding.
-    int currentSlimeScore; //!< How many slimes the character is holding score wise.
-    float zoneTimer; //!< How long the player needs to be in the zone.
-    float punchTimer; //!< Cooldown between punches
-    std::vector<int> slimeBag; //!< The bag of slimes.
-
-    static float acceleration; //!< How much character speed increases per tick
-    static float jumpSpeed; //!< The jump speed of the character
-    static float maxSpeed; //!< The max speed of the character
+    std::shared_ptr<Entity> entity_; //!< The entity the character should be acting upon
+    std::shared_ptr<cmp::Transform> transform_; //!< The entity's Transform, looked up on attach and released with the entity
+    std::shared_ptr<cmp::AdvancedBody> body_; //!< The entity's AdvancedBody, looked up on attach and released with the entity
+#ifndef FB_HEADLESS
+    std::shared_ptr<Sprite> sprite_; //!< The entity's Sprite, looked up on attach and released with the entity
+    std::shared_ptr<cmp::FistComponent> fist_; //!< The character's fist
+#endif
+    BoxCollider* punchBoxes_[PunchSlotCount]; //!< Preconfigured punch hitboxes, one per direction, owned by the character
+    int id; //!< The character's ID, and its slot in the state table
+
+    static KinematicScalar acceleration; //!< How much character speed increases per tick
+    static KinematicScalar jumpSpeed; //!< The jump speed of the character
+    static KinematicScalar maxSpeed; //!< The max speed of the character
     static float gravity; //!< How strong gravity will act
     static int drag; //!< How much character speed should be cut in midair
 };
@@ -0,0 +1,528 @@
+// Author:   James Liao
+// Copyright  2017 DigiPen (USA) Corporation.
+//
+// Microbenchmarks for the character hot paths. Only built into the benchmark
+// executable (character_bench in CMakeLists.txt), which defines
+// FB_CHARACTER_BENCH (and FB_HEADLESS, so every side effect goes to the null
+// sink). Results are written as JSON to stdout, or to the file named by the
+// first argument.
+//
+// Every case spawns its characters through CharacterManager::Init, which builds
+// them from the player and fist archetype JSON (playerA-D.json, fistA/B.json).
+// Run it from a directory where EntityManager can find the game's assets, the
+// build farm needs a copy of them next to the executable.
+#ifdef FB_CHARACTER_BENCH
+
+#include "CharacterHandler.h"
+#include "Character.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace fb;
+
+#define BENCH_SAMPLES 101     // How many timed samples each case takes
+#define BENCH_BATCH 1000      // How many operations each sample runs
+#define BENCH_WARMUP 5        // Untimed samples run before measuring
+#define BENCH_DT (1.0f / 60.0f) // Timestep of every simulated frame
+
+//------------------------------------------------------------------------------
+// Allocation counting
+//------------------------------------------------------------------------------
+
+static std::atomic<unsigned long long> allocationCount(0);
+
+void* operator new(std::size_t size)
+{
+  ++allocationCount;
+
+  if (void* memory = std::malloc(size ? size : 1))
+  {
+    return memory;
+  }
+
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+  std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+  std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+  std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+  std::free(memory);
+}
+
+//------------------------------------------------------------------------------
+// Harness
+//------------------------------------------------------------------------------
+
+namespace
+{
+  typedef std::chrono::steady_clock Clock;
+
+  //! Summary of one benchmark case
+  struct BenchResult
+  {
+    std::string name;
+    bool perOp;            //!< Whether each operation was timed on its own, with the timer overhead taken off
+    int characters;        //!< How many characters were alive while it ran
+    double nsPerOp;        //!< Mean over every sample
+    double allocsPerOp;    //!< Mean over every sample
+    double p50;            //!< Median ns/op
+    double p90;
+    double p99;
+    double min;
+    double max;
+  };
+
+  std::vector<BenchResult> results;
+  double timerOverhead = 0.0; // ns the two clock reads around one operation add, measured by CalibrateTimer
+
+  double Percentile(const std::vector<double>& sorted, double percent)
+  {
+    size_t index = static_cast<size_t>(percent * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+  }
+
+  /*!
+  *******************************************************************************
+  \brief   Takes the samples for one case and records its result
+  \param   name
+    Name the case is reported under (const char *).
+  \param   batch
+    How many operations one sample runs (int).
+  \param   perOp
+    Whether the sample times each operation on its own (bool).
+  \param   sample
+    Runs one batch and returns how long the measured part took (Sample).
+  \return  None (void).
+  *******************************************************************************/
+  template <typename Sample>
+  void Measure(const char* name, int batch, bool perOp, Sample sample)
+  {
+    std::vector<double> samples;
+    samples.reserve(BENCH_SAMPLES);
+    unsigned long long allocations = 0;
+    double totalNs = 0.0;
+
+    for (int i = -BENCH_WARMUP; i < BENCH_SAMPLES; ++i)
+    {
+      unsigned long long before = allocationCount;
+      Clock::duration elapsed = sample();
+
+      // Setup is allowed to allocate, so per-op cases only report an upper bound for the operation
+      unsigned long long allocated = allocationCount - before;
+
+      if (i < 0)
+      {
+        continue;
+      }
+
+      // Clock reads cost about as much as the cheapest operations, so take them back off
+      double ns = std::chrono::duration<double, std::nano>(elapsed).count() / batch;
+
+      if (perOp)
+      {
+        ns = std::max(0.0, ns - timerOverhead);
+      }
+
+      samples.push_back(ns);
+      totalNs += ns;
+      allocations += allocated;
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    BenchResult result;
+    result.name = name;
+    result.perOp = perOp;
+    result.characters = CharacterManager::GetPlayerCount();
+    result.nsPerOp = totalNs / samples.size();
+    result.allocsPerOp = static_cast<double>(allocations) / (static_cast<double>(batch) * samples.size());
+    result.p50 = Percentile(samples, 0.50);
+    result.p90 = Percentile(samples, 0.90);
+    result.p99 = Percentile(samples, 0.99);
+    result.min = samples.front();
+    result.max = samples.back();
+    results.push_back(result);
+  }
+
+  /*!
+  *******************************************************************************
+  \brief   Times an operation that needs its state put back before every run.
+           Each operation is timed on its own, and the cost of the clock reads
+           measured by CalibrateTimer is taken off.
+  \param   name
+    Name the case is reported under (const char *).
+  \param   batch
+    How many operations one sample runs (int).
+  \param   setup
+    Run before every operation and not timed, puts the state back (Setup).
+  \param   op
+    The operation being measured (Op).
+  \return  None (void).
+  *******************************************************************************/
+  template <typename Setup, typename Op>
+  void Run(const char* name, int batch, Setup setup, Op op)
+  {
+    Measure(name, batch, true, [batch, &setup, &op]()
+    {
+      Clock::duration elapsed = Clock::duration::zero();
+
+      for (int i = 0; i < batch; ++i)
+      {
+        setup(i);
+
+        Clock::time_point start = Clock::now();
+        op(i);
+        elapsed += Clock::now() - start;
+      }
+
+      return elapsed;
+    });
+  }
+
+  /*!
+  *******************************************************************************
+  \brief   Times an operation that can run back to back. The whole batch is
+           timed at once, so the clock reads don't count.
+  \param   name
+    Name the case is reported under (const char *).
+  \param   batch
+    How many operations one sample runs (int).
+  \param   op
+    The operation being measured (Op).
+  \return  None (void).
+  *******************************************************************************/
+  template <typename Op>
+  void Run(const char* name, int batch, Op op)
+  {
+    Measure(name, batch, false, [batch, &op]()
+    {
+      Clock::time_point start = Clock::now();
+
+      for (int i = 0; i < batch; ++i)
+      {
+        op(i);
+      }
+
+      return Clock::now() - start;
+    });
+  }
+
+  //! Measures what timing an empty operation on its own costs, per operation
+  void CalibrateTimer()
+  {
+    std::vector<double> samples;
+
+    for (int sample = 0; sample < BENCH_SAMPLES; ++sample)
+    {
+      Clock::duration elapsed = Clock::duration::zero();
+
+      for (int i = 0; i < BENCH_BATCH; ++i)
+      {
+        Clock::time_point start = Clock::now();
+        elapsed += Clock::now() - start;
+      }
+
+      samples.push_back(std::chrono::duration<double, std::nano>(elapsed).count() / BENCH_BATCH);
+    }
+
+    std::sort(samples.begin(), samples.end());
+    timerOverhead = Percentile(samples, 0.50);
+  }
+
+  void WriteJson(FILE* out)
+  {
+    fprintf(out, "{\n  \"benchmarks\": [\n");
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+      const BenchResult& r = results[i];
+      fprintf(out,
+        "    { \"name\": \"%s\", \"timing\": \"%s\", \"characters\": %d, \"ns_per_op\": %.3f, \"allocs_per_op\": %.4f, "
+        "\"p50_ns\": %.3f, \"p90_ns\": %.3f, \"p99_ns\": %.3f, \"min_ns\": %.3f, \"max_ns\": %.3f }%s\n",
+        r.name.c_str(), r.perOp ? "per_op" : "batch", r.characters, r.nsPerOp, r.allocsPerOp, r.p50, r.p90, r.p99, r.min, r.max,
+        i + 1 < results.size() ? "," : "");
+    }
+
+    fprintf(out, "  ],\n  \"samples\": %d,\n  \"batch\": %d,\n  \"timer_overhead_ns\": %.3f\n}\n", BENCH_SAMPLES, BENCH_BATCH, timerOverhead);
+  }
+
+  //------------------------------------------------------------------------------
+  // World setup
+  //------------------------------------------------------------------------------
+
+  // Movement values close to the shipped globals, so the benchmark needs no JSON
+  void LoadBenchGlobals()
+  {
+    Character::SetAcceleration(1.0f);
+    Character::SetJumpSpeed(12.0f);
+    Character::SetMaxSpeed(8.0f);
+    Character::SetGravity(-30.0f);
+    Character::SetDrag(2);
+  }
+
+  void Spawn(int count)
+  {
+    CharacterManager::RemoveFromEntityManager();
+    CharacterManager::Shutdown();
+    CharacterManager::Init(count);
+    CharacterManager::AddToEntityManager();
+
+    // Spread everyone out so only the cases that want targets get them
+    for (int i = 0; i < CharacterManager::GetPlayerCount(); ++i)
+    {
+      CharacterManager::SetCharacterPosition(i, glm::vec2(i * 100.0f, 0.0f));
+    }
+  }
+
+  //! Pretends the contact queries already ran this frame with the given result
+  void FakeContacts(int id, ContactMask touching)
+  {
+    CharacterContacts& contacts = CharacterManager::GetContacts(id);
+    contacts.Invalidate();
+    contacts.evaluated = ALL_CONTACTS;
+    contacts.touching = touching;
+  }
+
+  //! Puts a character back on the ground, at rest, ready to jump and punch
+  void Ground(int id)
+  {
+    Character* character = CharacterManager::GetCharacter(id);
+    character->getBody()->SetVelocity(glm::vec2(0.0f, 0.0f));
+    character->setOnFloor(true);
+    character->setFirstJump(false);
+    character->setJump(false);
+    character->setHit(false);
+    character->removeLimiter();
+    CharacterManager::GetStateTable().punchTimer[id] = 0.0f;
+  }
+
+  //------------------------------------------------------------------------------
+  // Cases
+  //------------------------------------------------------------------------------
+
+  void BenchMove()
+  {
+    Spawn(4);
+    Character* character = CharacterManager::GetCharacter(0);
+
+    Run("Character::move", BENCH_BATCH, [character](int i)
+    {
+      character->move(i & 1 ? Left : Right);
+    });
+  }
+
+  void BenchJumps()
+  {
+    Spawn(4);
+    Character* character = CharacterManager::GetCharacter(0);
+
+    Run("Character::jump/ground", BENCH_BATCH, [](int)
+    {
+      Ground(0);
+    }, [character](int)
+    {
+      character->jump(Right);
+    });
+
+    Run("Character::jump/wall", BENCH_BATCH, [character](int)
+    {
+      Ground(0);
+      character->setOnFloor(false);
+      character->setFirstJump(true);
+      FakeContacts(0, CONTACT_BIT(WorldLeft));
+    }, [character](int)
+    {
+      character->jump(Left);
+    });
+
+    Run("Character::jump/double", BENCH_BATCH, [character](int)
+    {
+      Ground(0);
+      character->setOnFloor(false);
+      character->setFirstJump(true);
+      character->setJump(true);
+      FakeContacts(0, 0);
+    }, [character](int)
+    {
+      character->jump(Right);
+    });
+
+    CharacterManager::GetContacts(0).Invalidate();
+  }
+
+  void BenchAttack(int targets)
+  {
+    Spawn(targets + 1);
+    targets = CharacterManager::GetPlayerCount() - 1;
+
+    // Stack every target inside the right punch hitbox
+    glm::vec2 origin = CharacterManager::GetCharacter(0)->getTransform()->GetPosition();
+
+    for (int i = 1; i <= targets; ++i)
+    {
+      CharacterManager::SetCharacterPosition(i, origin + glm::vec2(1.0f, 0.0f));
+    }
+
+    std::string name = "Character::resolvePunch/" + std::string(targets ? "hit/" : "miss/") + std::to_string(targets);
+    Character* attacker = CharacterManager::GetCharacter(0);
+    ContactArena& arena = CharacterManager::GetContactArena();
+
+    // The hits are what the tick does with a queued punch, without the rest of the tick
+    Run(name.c_str(), BENCH_BATCH, [targets, origin, &arena](int)
+    {
+      for (int i = 0; i <= targets; ++i)
+      {
+        Ground(i);
+      }
+
+      for (int i = 1; i <= targets; ++i)
+      {
+        CharacterManager::SetCharacterPosition(i, origin + glm::vec2(1.0f, 0.0f));
+      }
+
+      arena.Reset();
+    }, [attacker, &arena](int)
+    {
+      attacker->resolvePunch(Right, attacker->queryPunch(Right, arena));
+    });
+  }
+
+  void BenchBasicAttack()
+  {
+    Spawn(4);
+    Character* attacker = CharacterManager::GetCharacter(0);
+
+    // Only queues the punch, the queue is emptied by a tick outside the timing
+    Run("Character::basicAttack", BENCH_BATCH, [](int)
+    {
+      CharacterManager::Step(BENCH_DT);
+      Ground(0);
+    }, [attacker](int)
+    {
+      attacker->basicAttack(Right);
+    });
+  }
+
+  void BenchSlimeBag()
+  {
+    Spawn(4);
+    Character* character = CharacterManager::GetCharacter(0);
+
+    Run("Character::addSlime", BENCH_BATCH, [character](int i)
+    {
+      if (i % SLIME_BAG_CAPACITY == 0)
+        character->clearSlimeBagWeight();
+    }, [character](int i)
+    {
+      character->addSlime(i % 3 ? SLIME_NORMAL_WEIGHT : SLIME_GOLDEN_WEIGHT);
+    });
+
+    Run("Character::popSlime", BENCH_BATCH, [character](int i)
+    {
+      if (i % SLIME_BAG_CAPACITY == 0)
+      {
+        character->clearSlimeBagWeight();
+
+        for (int j = 0; j < SLIME_BAG_CAPACITY; ++j)
+          character->addSlime(j % 3 ? SLIME_NORMAL_WEIGHT : SLIME_GOLDEN_WEIGHT);
+      }
+    }, [character](int)
+    {
+      character->popSlime();
+    });
+  }
+
+  void BenchStep(int count)
+  {
+    Spawn(count);
+
+    // Every character gets a steady stream of input, like a real match
+    std::string name = "CharacterManager::Step/" + std::to_string(count);
+    Run(name.c_str(), BENCH_BATCH / 10, [](int frame)
+    {
+      for (int i = 0; i < CharacterManager::GetPlayerCount(); ++i)
+      {
+        CharacterManager::SubmitInput(i, VerbMove, (frame + i) & 1 ? Left : Right);
+
+        if ((frame + i) % 8 == 0)
+          CharacterManager::SubmitInput(i, VerbJump, Up);
+
+        if ((frame + i) % 16 == 0)
+          CharacterManager::SubmitInput(i, VerbBasicAttack, Right);
+      }
+    }, [](int)
+    {
+      CharacterManager::Step(BENCH_DT);
+    });
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  LoadBenchGlobals();
+  CalibrateTimer();
+
+  BenchMove();
+  BenchJumps();
+
+  BenchBasicAttack();
+
+  for (int targets : { 0, 1, 3, 7 })
+  {
+    BenchAttack(targets);
+  }
+
+  BenchSlimeBag();
+
+  for (int count : { 4, 16, 64, 256 })
+  {
+    BenchStep(count);
+  }
+
+  CharacterManager::RemoveFromEntityManager();
+  CharacterManager::Shutdown();
+
+  FILE* out = stdout;
+
+  if (argc > 1 && !(out = fopen(argv[1], "w")))
+  {
+    fprintf(stderr, "Could not open %s\n", argv[1]);
+    return 1;
+  }
+
+  WriteJson(out);
+
+  if (out != stdout)
+  {
+    fclose(out);
+  }
+
+  return 0;
+}
+
+#endif
@@ -0,0 +1,63 @@
+// Author:   James Liao
+// Copyright  2017 DigiPen (USA) Corporation.
+#include "CharacterChecksum.h"
+#include <cstring>
+#include <iomanip>
+
+#define CHECKSUM_SEED 0xcbf29ce484222325ull // FNV offset basis, any odd start works
+#define CHECKSUM_PRIME 0x9e3779b97f4a7c15ull // Golden ratio multiplier
+
+namespace
+{
+  // One multiply and a fold per word, cheap enough to run for every character every frame
+  inline uint64_t Mix(uint64_t hash, uint32_t word)
+  {
+    hash = (hash ^ word) * CHECKSUM_PRIME;
+    return hash ^ (hash >> 32);
+  }
+
+  // Hashes the bits, so -0 and 0 or different NaNs count as different states
+  inline uint32_t Bits(float value)
+  {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+}
+
+void CharacterChecksum::Begin(uint32_t newFrame)
+{
+  frame = newFrame;
+  running = Mix(CHECKSUM_SEED, newFrame);
+}
+
+void CharacterChecksum::Add(int id, const CharacterStateTable& states, glm::vec2 position, glm::vec2 velocity)
+{
+  const SlimeBag& bag = states.slimeBag[id];
+
+  uint64_t hash = CHECKSUM_SEED;
+  hash = Mix(hash, states.flags[id] | (bag.normal << 8) | (bag.golden << 16) | (bag.capacity << 24));
+  hash = Mix(hash, Bits(states.punchTimer[id]));
+  hash = Mix(hash, Bits(states.zoneTimer[id]));
+  hash = Mix(hash, Bits(position.x));
+  hash = Mix(hash, Bits(position.y));
+  hash = Mix(hash, Bits(velocity.x));
+  hash = Mix(hash, Bits(velocity.y));
+
+  characterChecksum[id] = hash;
+
+  // Order matters, so swapping two characters' states changes the checksum
+  running = Mix(Mix(running, static_cast<uint32_t>(hash)), static_cast<uint32_t>(hash >> 32));
+}
+
+uint64_t CharacterChecksum::End()
+{
+  checksum = running;
+
+  if (log)
+  {
+    *log << frame << ' ' << std::hex << std::setw(16) << std::setfill('0') << checksum << std::dec << '\n';
+  }
+
+  return checksum;
+}
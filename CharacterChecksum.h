@@ -0,0 +1,63 @@
+// Copyright  2017 DigiPen (USA) Corporation.
+/*!
+*******************************************************************************
+\file    CharacterChecksum.h
+\author  James Liao
+\par     email: james.liao\@digipen.edu
+\par     Course: GAM200F17-A
+\brief   Per-frame checksum of the character simulation. Characters are
+         folded in one at a time while the frame is being simulated, and
+         each keeps its own hash so a mismatch can be traced to a character.
+*******************************************************************************/
+
+#pragma once
+#include "CharacterState.h"
+#include "glm/vec2.hpp"
+#include <cstdint>
+#include <ostream>
+
+struct CharacterChecksum
+{
+  /*!
+  *******************************************************************************
+  \brief   Starts the checksum for a new frame
+  \param   frame
+    The frame being checksummed (uint32_t).
+  \return  None (void).
+  *******************************************************************************/
+  void Begin(uint32_t frame);
+
+  /*!
+  *******************************************************************************
+  \brief   Folds one character into the frame's checksum. Characters must be
+           added in ID order.
+  \param   id
+    The character's ID (int).
+  \param   states
+    The table holding the character's state (const CharacterStateTable &).
+  \param   position
+    Position of the character's transform (glm::vec2).
+  \param   velocity
+    Velocity of the character's body (glm::vec2).
+  \return  None (void).
+  *******************************************************************************/
+  void Add(int id, const CharacterStateTable& states, glm::vec2 position, glm::vec2 velocity);
+
+  /*!
+  *******************************************************************************
+  \brief   Finishes the frame's checksum, and writes it to the log stream if
+           one is set
+  \return  The frame's checksum (uint64_t).
+  *******************************************************************************/
+  uint64_t End();
+
+  uint64_t Get() const { return checksum; }                                  //!< Checksum of the last finished frame
+  uint64_t GetCharacter(int id) const { return characterChecksum[id]; }      //!< Hash of one character in the last frame
+  void SetLog(std::ostream* stream) { log = stream; }                        //!< Where to write "frame checksum" lines, NULL for nowhere
+
+  uint32_t frame = 0;                                //!< Frame being or last checksummed
+  uint64_t running = 0;                              //!< Checksum of the characters added so far
+  uint64_t checksum = 0;                             //!< Checksum of the last finished frame
+  uint64_t characterChecksum[MAX_CHARACTERS] = {};   //!< Hash of each character in the last frame
+  std::ostream* log = nullptr;                       //!< Optional log stream
+};
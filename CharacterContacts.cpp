@@ -0,0 +1,47 @@
+// Author:   James Liao
+// Copyright  2017 DigiPen (USA) Corporation.
+#include "CharacterContacts.h"
+
+using namespace fb;
+
+namespace
+{
+  //! Which detector set and side each ContactQuery runs
+  struct ContactQueryDesc
+  {
+    Layer layer;
+    cmp::AdvancedDetectors side;
+  };
+
+  const ContactQueryDesc contactQueries[ContactQueryCount] =
+  {
+    { goal, cmp::AdvancedDetectors::BODY }, // GoalBody
+    { world, cmp::TOP },                    // WorldTop
+    { world, cmp::LEFT },                   // WorldLeft
+    { world, cmp::RIGHT },                  // WorldRight
+    { world, cmp::BOTTOM },                 // WorldBottom
+    { slime, cmp::BOTTOM },                 // SlimeBottom
+    { ghost, cmp::BOTTOM }                  // GhostBottom
+  };
+}
+
+void CharacterContacts::Query(cmp::AdvancedBody& body, ContactMask wanted, ContactArena& arena)
+{
+  ContactMask pending = wanted & ~evaluated;
+
+  for (int i = 0; pending; ++i, pending >>= 1)
+  {
+    if (pending & 1u)
+    {
+      CollisionResult result = body.RunDetection(contactQueries[i].layer, contactQueries[i].side);
+      colliders[i] = arena.Store(result);
+
+      if (result.collision)
+      {
+        touching |= CONTACT_BIT(i);
+      }
+    }
+  }
+
+  evaluated |= wanted;
+}
@@ -0,0 +1,78 @@
+// Copyright  2017 DigiPen (USA) Corporation.
+/*!
+*******************************************************************************
+\file    CharacterContacts.h
+\author  James Liao
+\par     email: james.liao\@digipen.edu
+\par     Course: GAM200F17-A
+\brief   Batched contact queries for a character's AdvancedBody. Every side
+         and layer the character cares about is evaluated in one sweep and
+         kept until the end of the frame as a bit mask plus collider spans.
+*******************************************************************************/
+
+#pragma once
+#include "AdvancedBody.h"
+#include "ContactArena.h"
+#include <cstdint>
+
+namespace fb
+{
+  //! The side/layer pairs a character is checked against each frame
+  enum ContactQuery
+  {
+    GoalBody,     //!< Whole body against goal zones
+    WorldTop,     //!< Top detector against the world
+    WorldLeft,    //!< Left detector against the world
+    WorldRight,   //!< Right detector against the world
+    WorldBottom,  //!< Bottom detector against the world
+    SlimeBottom,  //!< Bottom detector against slimes
+    GhostBottom,  //!< Bottom detector against passable platforms
+    ContactQueryCount
+  };
+
+  typedef uint32_t ContactMask; //!< One bit per ContactQuery
+
+  #define CONTACT_BIT(query) (1u << (query))                       //!< Mask bit for a single query
+  #define ALL_CONTACTS ((1u << ContactQueryCount) - 1)              //!< Mask with every query set
+
+  struct CharacterContacts
+  {
+    /*!
+    *******************************************************************************
+    \brief   Runs every wanted query that has not been run since the last
+             Invalidate, in a single pass over the query table
+    \param   body
+      The body to run the detectors of (cmp::AdvancedBody &).
+    \param   wanted
+      Which queries the caller needs (ContactMask).
+    \param   arena
+      Where to keep the colliders found by the queries (ContactArena &).
+    \return  None (void).
+    *******************************************************************************/
+    void Query(cmp::AdvancedBody& body, ContactMask wanted, ContactArena& arena);
+
+    /*!
+    *******************************************************************************
+    \brief   Forgets every result, so the next Query runs the detectors again
+    \return  None (void).
+    *******************************************************************************/
+    void Invalidate() { evaluated = 0; touching = 0; }
+
+    /*!
+    *******************************************************************************
+    \brief   Forgets the results of some queries, so the next Query runs just
+             those detectors again
+    \param   queries
+      Which queries to forget (ContactMask).
+    \return  None (void).
+    *******************************************************************************/
+    void Invalidate(ContactMask queries) { evaluated &= ~queries; touching &= ~queries; }
+
+    bool Has(ContactQuery query) const { return (touching & CONTACT_BIT(query)) != 0; } //!< Whether or not a query reported a collision
+    const ContactSpan& Colliders(ContactQuery query) const { return colliders[query]; } //!< Colliders found by a query
+
+    ContactMask evaluated; //!< Which queries have been run since the last Invalidate
+    ContactMask touching;  //!< Which of those queries reported a collision
+    ContactSpan colliders[ContactQueryCount]; //!< Colliders found by each query, stored in the frame's arena
+  };
+}
@@ -0,0 +1,85 @@
+// Author:   James Liao
+// Copyright  2017 DigiPen (USA) Corporation.
+#include "CharacterEventQueue.h"
+
+using namespace fb;
+
+#define EVENT_QUEUE_RESERVE (MAX_CHARACTERS * 4) // Room for a busy frame without reallocating
+
+CharacterEventQueue::CharacterEventQueue() : tickStart_(0)
+{
+  events_.reserve(EVENT_QUEUE_RESERVE);
+  characters_.reserve(EVENT_QUEUE_RESERVE);
+  counts_.reserve(EVENT_QUEUE_RESERVE);
+  touched_.reserve(MAX_CHARACTERS + 1);
+
+  for (int i = 0; i <= MAX_CHARACTERS; ++i)
+  {
+    seen_[i] = 0;
+  }
+}
+
+void CharacterEventQueue::Push(int character, const evt::CharacterEvent& event)
+{
+  int type = static_cast<int>(event.type);
+
+  // Types that don't fit the mask are never coalesced
+  if (type >= 0 && type < 32)
+  {
+    uint16_t row = static_cast<uint16_t>(character + 1);
+    uint32_t bit = 1u << type;
+
+    if (seen_[row] & bit)
+    {
+      // Only events from this tick are in the mask, so the search stops at the start of the tick
+      for (size_t i = events_.size(); i-- > tickStart_;)
+      {
+        if (characters_[i] == character && events_[i].type == event.type)
+        {
+          ++counts_[i];
+          return;
+        }
+      }
+    }
+
+    if (!seen_[row])
+    {
+      touched_.push_back(row);
+    }
+
+    seen_[row] |= bit;
+  }
+
+  events_.push_back(event);
+  characters_.push_back(character);
+  counts_.push_back(1);
+}
+
+void CharacterEventQueue::EndTick()
+{
+  for (uint16_t row : touched_)
+  {
+    seen_[row] = 0;
+  }
+
+  touched_.clear();
+  tickStart_ = events_.size();
+}
+
+void CharacterEventQueue::Flush(CharacterSink& sink)
+{
+  for (size_t i = 0; i < events_.size(); ++i)
+  {
+    sink.Notify(characters_[i], events_[i], counts_[i]);
+  }
+
+  Clear();
+}
+
+void CharacterEventQueue::Clear()
+{
+  events_.clear();
+  characters_.clear();
+  counts_.clear();
+  EndTick();
+}
@@ -0,0 +1,77 @@
+// Copyright  2017 DigiPen (USA) Corporation.
+/*!
+*******************************************************************************
+\file    CharacterEventQueue.h
+\author  James Liao
+\par     email: james.liao\@digipen.edu
+\par     Course: GAM200F17-A
+\brief   Per-frame buffer of character events. Events are recorded during the
+         simulation and handed to observers in one batch, with duplicates
+         dropped.
+*******************************************************************************/
+
+#pragma once
+#include "CharacterSink.h"
+#include "CharacterState.h"
+#include <cstdint>
+#include <vector>
+
+namespace fb
+{
+  class CharacterEventQueue
+  {
+    public:
+      CharacterEventQueue();
+
+      /*!
+      *******************************************************************************
+      \brief   Records an event. If the same character already sent one of the
+               same type this tick, the two are merged and the earlier one's
+               count goes up instead.
+      \param   character
+        ID of the character the event is about, or -1 if it is not about one
+        character (int).
+      \param   event
+        The event to record (const evt::CharacterEvent &).
+      \return  None (void).
+      *******************************************************************************/
+      void Push(int character, const evt::CharacterEvent& event);
+
+      /*!
+      *******************************************************************************
+      \brief   Ends the tick events are merged within. Events pushed after this
+               are never merged with earlier ones, though all of them are still
+               waiting for Flush.
+      \return  None (void).
+      *******************************************************************************/
+      void EndTick();
+
+      /*!
+      *******************************************************************************
+      \brief   Sends every recorded event to a sink in the order they were first
+               pushed, along with how many copies were merged into each, then
+               empties the queue
+      \param   sink
+        Where to send the events (CharacterSink &).
+      \return  None (void).
+      *******************************************************************************/
+      void Flush(CharacterSink& sink);
+
+      /*!
+      *******************************************************************************
+      \brief   Drops every recorded event without sending it
+      \return  None (void).
+      *******************************************************************************/
+      void Clear();
+
+      size_t Size() const { return events_.size(); } //!< How many events are waiting
+
+    private:
+      std::vector<evt::CharacterEvent> events_; //!< Events waiting to be sent, contiguous and in order
+      std::vector<int> characters_;             //!< Character each waiting event is about
+      std::vector<int> counts_;                 //!< How many pushes were merged into each waiting event
+      size_t tickStart_;                        //!< First event pushed this tick, only these can be merged into
+      std::vector<uint16_t> touched_;           //!< Which rows of seen_ have bits set
+      uint32_t seen_[MAX_CHARACTERS + 1];       //!< Event types already queued this tick, one row per character plus one for -1
+  };
+}
@@ -0,0 +1,30 @@
+// Author:   James Liao
+// Copyright  2017 DigiPen (USA) Corporation.
+#include "CharacterEventRouter.h"
+
+using namespace fb;
+
+std::unordered_map<uint32_t, CharacterEventSubject> CharacterEventRouter::subjects;
+
+void CharacterEventRouter::Notify(int character, const evt::CharacterEvent& event)
+{
+  int type = static_cast<int>(event.type);
+
+  // Only 32 types fit in a subscription mask
+  if (type < 0 || type >= 32)
+  {
+    return;
+  }
+
+  auto subject = subjects.find(Key(character, type));
+
+  if (subject != subjects.end())
+  {
+    subject->second.Notify(event);
+  }
+}
+
+void CharacterEventRouter::Clear()
+{
+  subjects.clear();
+}
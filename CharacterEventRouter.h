@@ -0,0 +1,77 @@
+// Copyright  2017 DigiPen (USA) Corporation.
+/*!
+*******************************************************************************
+\file    CharacterEventRouter.h
+\author  James Liao
+\par     email: james.liao\@digipen.edu
+\par     Course: GAM200F17-A
+\brief   Character event subscriptions filtered by character and event type.
+         Every (character, type) pair gets its own subject, so Notify only
+         reaches the observers that asked for it.
+*******************************************************************************/
+
+#pragma once
+#include "EventManager.h"
+#include <cstdint>
+#include <type_traits>
+#include <unordered_map>
+
+#define ALL_CHARACTER_EVENTS 0xFFFFFFFFu //!< Event type mask that matches every type
+
+namespace fb
+{
+  //! Same subject type as the global character event subject
+  typedef std::remove_reference<decltype(evt::EventManager::GetCharacterEventSubject())>::type CharacterEventSubject;
+
+  class CharacterEventRouter
+  {
+    public:
+      /*!
+      *******************************************************************************
+      \brief   Registers an observer for some event types from one character
+      \param   character
+        ID of the character to listen to, or -1 for events that are not about
+        one character (int).
+      \param   typeMask
+        One bit per event type to listen for, see ALL_CHARACTER_EVENTS (uint32_t).
+      \param   observer
+        The observer, in whatever form the subject registers (const ObserverPtr &).
+      \return  None (void).
+      *******************************************************************************/
+      template <typename ObserverPtr>
+      static void Subscribe(int character, uint32_t typeMask, const ObserverPtr& observer)
+      {
+        for (int type = 0; typeMask; ++type, typeMask >>= 1)
+        {
+          if (typeMask & 1u)
+          {
+            subjects[Key(character, type)].RegisterObserver(observer);
+          }
+        }
+      }
+
+      /*!
+      *******************************************************************************
+      \brief   Sends an event to the observers of that character and event type
+      \param   character
+        ID of the character the event is about, or -1 (int).
+      \param   event
+        The event to send (const evt::CharacterEvent &).
+      \return  None (void).
+      *******************************************************************************/
+      static void Notify(int character, const evt::CharacterEvent& event);
+
+      /*!
+      *******************************************************************************
+      \brief   Drops every subscription
+      \return  None (void).
+      *******************************************************************************/
+      static void Clear();
+
+    private:
+      //! Packs a character and an event type into a map key
+      static uint32_t Key(int character, int type) { return (static_cast<uint32_t>(character + 1) << 5) | static_cast<uint32_t>(type); }
+
+      static std::unordered_map<uint32_t, CharacterEventSubject> subjects; //!< One subject per (character, type) with observers
+  };
+}
@@ -3,88 +3,149 @@
 #include "CharacterHandler.h"
 #include "Transform.h"
 #include "BasicBody.h"
-#include "Texture.h"
-#include "Sprite.h"
-#include "glm\vec2.hpp"
+#include "glm/vec2.hpp"
 #include "EntityManager.h"
 #include "PhysicsManager.h"
 #include "DudeAI.h"
 #include "ComponentFactory.h"
 #include "LevelLoading.h"
 #include <string>
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <fstream>
 #include <rapidjson/istreamwrapper.h>
 #include "Score.h"
-#include "ControllerHandler.h"
-#include "SDL2\SDL.h"
 #include "Time.h"
-#include "MakeParticles.h"
-#include "PopupText.h"
-#include "WrapperObject.h"
 #include "AdvancedBody.h"
-#include "FistComponent.h"
 #include "EventManager.h"
+#include "TargetRegistry.h"
+#include "CharacterContacts.h"
+#include "JobSystem.h"
+#include "CharacterReplay.h"
+#include "CharacterEventRouter.h"
+
+#ifndef FB_HEADLESS
+#include "ControllerHandler.h"
+#include "EngineCharacterSink.h"
+#include "HapticsScheduler.h"
+#include "SquashPool.h"
+#include "FistComponent.h"
+#include "Texture.h"
+#include "Sprite.h"
+#endif
 
 using namespace fb;
 using namespace glm;
 
-#define MAX_USERS 4
 #define BOUNCE_MODIFIER 5
+#define UPDATE_GRAIN 16 // How many characters each job in the compute phase handles
+#define SQUASH_POOL_SIZE 16 // Shared squash tweens made up front
 
 // Forward declarations
-std::vector<Character *> CharacterManager::characters;
+std::vector<Character> CharacterManager::characters;
+CharacterStateTable CharacterManager::states;
+CharacterContacts CharacterManager::contacts[MAX_CHARACTERS];
+ContactArena CharacterManager::contactArena;
+std::vector<PunchRequest> CharacterManager::punches;
+std::vector<InputCommand> CharacterManager::commands;
+CharacterIntent CharacterManager::intents[MAX_CHARACTERS];
+uint32_t CharacterManager::frame;
+float CharacterManager::frameDt;
+std::vector<EntityPtr> CharacterManager::stompedDudes;
+uint32_t CharacterManager::randomState = 1;
+CharacterChecksum CharacterManager::checksum;
+CharacterSnapshot CharacterManager::history[SNAPSHOT_HISTORY];
+bool CharacterManager::keepSnapshots;
+bool CharacterManager::inGoal[MAX_CHARACTERS];
+vec2 CharacterManager::bodyPosition[MAX_CHARACTERS];
+vec2 CharacterManager::bodyVelocity[MAX_CHARACTERS];
+std::vector<BufferedCharacterSink> CharacterManager::workerEffects;
+CharacterEventQueue CharacterManager::events;
+StringId CharacterManager::trailNames[MAX_CHARACTERS];
+BufferedCharacterSink CharacterManager::frameEffects;
 bool CharacterManager::isActive;
 DocumentPtr CharacterManager::jsonGlobal;
+NullCharacterSink CharacterManager::nullSink;
+CharacterSink* CharacterManager::sink = &CharacterManager::nullSink;
+
+// Archetype file and name for each player slot
+static const char* playerArchetypeFiles[PLAYER_SLOTS] = { "playerA.json", "playerB.json", "playerC.json", "playerD.json" };
+static const char* playerArchetypes[PLAYER_SLOTS] = { "PlayerA", "PlayerB", "PlayerC", "PlayerD" };
+
+// Where each player slot's deliveries are scored
+static const decltype(Score::player1) scoreSlots[PLAYER_SLOTS] = { Score::player1, Score::player2, Score::player3, Score::player4 };
+
+#ifndef FB_HEADLESS
+// Fist texture for each player slot
+static const char* fistTextures[PLAYER_SLOTS] =
+{
+  "assets/img/RedFist.png",
+  "assets/img/BlueFist.png",
+  "assets/img/YellowFist.png",
+  "assets/img/GreyFist.png"
+};
+#endif
 
-// Each player needs their own instance of the Character class
 void CharacterManager::Init()
 {
+#ifndef FB_HEADLESS
+  // The game sends every side effect to the engine
+  static EngineCharacterSink engineSink;
+  SetSink(&engineSink);
+  engineSink.StartHaptics();
+
+  // Create as many characters as controllers attached
+  Init(std::max(1, ControllerManager::GetNumPlayers()));
+#else
+  Init(1);
+#endif
+}
+
+// Each player needs their own instance of the Character class
+void CharacterManager::Init(int count)
+{
+  // The state table has a fixed number of slots
+  count = std::min(count, MAX_CHARACTERS);
+
   // Load each of the character JSON archetypes
-  EntityManager::LoadArchetype("playerA.json");
-  EntityManager::LoadArchetype("playerB.json");
-  EntityManager::LoadArchetype("playerC.json");
-  EntityManager::LoadArchetype("playerD.json");
+  for (int slot = 0; slot < PLAYER_SLOTS; ++slot)
+  {
+    EntityManager::LoadArchetype(playerArchetypeFiles[slot]);
+  }
 
   // Load the fist JSON archetypes (used when a fighter punches)
   EntityManager::LoadArchetype("fistA.json");
   EntityManager::LoadArchetype("fistB.json");
 
-  // Create as many characters as controllers attached
-  for (int i = 0; i < max(1, ControllerManager::GetNumPlayers()); i++)
-  {
-    if (characters.size() > 4)
-      Logger::Msg("HF");
+#ifndef FB_HEADLESS
+  // Tweens for anything squashed that isn't a character
+  SquashPool::Init(SQUASH_POOL_SIZE);
+#endif
 
-    characters.push_back(new Character(i));
+  // The compute phase of Update needs an effects buffer per worker
+  JobSystem::Init();
+  workerEffects.resize(JobSystem::GetWorkerCount());
 
-    EntityPtr player;
+  // Handles are stored by value, so reserve up front to keep GetCharacter pointers stable
+  characters.reserve(MAX_CHARACTERS);
+  punches.reserve(MAX_CHARACTERS);
+  commands.reserve(MAX_CHARACTERS * VerbCount);
+  stompedDudes.reserve(MAX_CHARACTERS);
 
-    std::shared_ptr<Entity> fistEntity = std::make_shared<Entity>("fist");
-    auto fistTrans = std::make_shared<cmp::Transform>();
-    fistTrans->SetScale(1.1f, 1.1f);
-    fistEntity->AttachComponent(fistTrans);
-    
+  // Every match rolls differently, replays record this seed and set it back with SetRandomState
+  uint64_t seed = static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+  SetRandomState(static_cast<uint32_t>(seed ^ (seed >> 32)));
 
-    switch (i)
-    {
-      case 0:
-        player = EntityManager::CreateEntity("PlayerA");
-        fistEntity->AttachComponent(std::make_shared<Sprite>("assets/img/RedFist.png", 1, RenderTexture::Layer::player_front_layer));
-        break;
-      case 1:
-        player = EntityManager::CreateEntity("PlayerB");
-        fistEntity->AttachComponent(std::make_shared<Sprite>("assets/img/BlueFist.png", 1, RenderTexture::Layer::player_front_layer));
-        break;
-      case 2:
-        player = EntityManager::CreateEntity("PlayerC");
-        fistEntity->AttachComponent(std::make_shared<Sprite>("assets/img/YellowFist.png", 1, RenderTexture::Layer::player_front_layer));
-        break;
-      case 3:
-        player = EntityManager::CreateEntity("PlayerD");
-        fistEntity->AttachComponent(std::make_shared<Sprite>("assets/img/GreyFist.png", 1, RenderTexture::Layer::player_front_layer));
-        break;
-    }
+  for (int i = 0; i < count; i++)
+  {
+    characters.emplace_back(i);
+
+    // Named once here so dropping slimes never has to build the string
+    trailNames[i] = StringTable::Intern("CharacterTrail" + std::to_string(GetSlot(i) + 1));
+
+    // Characters past the last player slot reuse the slots' archetypes in turn
+    EntityPtr player = EntityManager::CreateEntity(playerArchetypes[GetSlot(i)]);
 
     // Set the entity name to match the player
     player->SetName("Player " + std::to_string(i));
@@ -98,69 +159,113 @@ void CharacterManager::Init()
     body->CreateDetectorSet(king);
     body->CreateDetectorSet(ghost);
     body->CreateDetectorSet(goal);
-    
-    auto fistComp = std::make_shared<cmp::FistComponent>();
-    fistEntity->AttachComponent(fistComp);
-    fistEntity->SetParent(player);
-    EntityManager::AddEntity(fistEntity);
-    evt::EventManager::GetCharacterEventSubject().RegisterObserver(fistComp);
     //body->SetWorldFriction(0.2f);
 
     // Make side colliders for each character
     //CollisionLayer worldLayer(base, world);
     //CollisionLayer bottomLayer(base, world | slime | king | ghost);
     
-    characters[i]->attachEntity(player);
+    characters[i].attachEntity(player);
+    TargetRegistry::Register(player.get(), TargetCharacter, i);
+    characters[i].createPunchHitboxes();
+
+#ifndef FB_HEADLESS
+    // The fist is only ever drawn, so there is nothing to make without a renderer
+    std::shared_ptr<Entity> fistEntity = std::make_shared<Entity>("fist");
+    auto fistTrans = std::make_shared<cmp::Transform>();
+    fistTrans->SetScale(1.1f, 1.1f);
+    fistEntity->AttachComponent(fistTrans);
+    fistEntity->AttachComponent(std::make_shared<Sprite>(fistTextures[GetSlot(i)], 1, RenderTexture::Layer::player_front_layer));
+
+    auto fistComp = std::make_shared<cmp::FistComponent>();
+    fistEntity->AttachComponent(fistComp);
+    fistEntity->SetParent(player);
+    EntityManager::AddEntity(fistEntity);
+    characters[i].attachFist(fistComp);
+    CharacterEventRouter::Subscribe(i, ALL_CHARACTER_EVENTS, characters[i].getFist());
+
+    // Every jump and hit squashes the character, so it keeps a tween of its own
+    SquashPool::Reserve(player.get());
+#endif
 
     // Characters are not active until they are added to the entity manager
     isActive = false;
 
     /*
-    for (unsigned i = 0; i < MAX_USERS; ++i)
-      characters[i]->getEntity()->AttachComponent(std::make_shared<WrapperObject>(WrapperObject()));
+    for (unsigned i = 0; i < PLAYER_SLOTS; ++i)
+      characters[i].getEntity()->AttachComponent(std::make_shared<WrapperObject>(WrapperObject()));
     */
   }
+
+  // The archetype sprites face whichever way they were drawn, not the way the state table says
+  ShowFacing();
 }
 
 void CharacterManager::Update()
 {
-  // Only update characters while not paused
-  if (Time::GetTimescale() == 0) { return; }
+  // Only update characters while not paused, inputs made while paused are dropped
+  if (Time::GetTimescale() == 0)
+  {
+    commands.clear();
+    FlushEffects();
+    return;
+  }
 
+  // The engine integrates the bodies and refreshes their contacts once per rendered frame, so the characters tick with it
+  Step(Time::GetDT());
+}
 
+void CharacterManager::Step(float dt)
+{
+  Tick(dt);
 
-  // Update each character
-  for (int i = 0; i < characters.size(); i++)
-  {
-    auto trans = characters[i]->getEntity()->GetComponent<fb::cmp::Transform>();
-    auto body = characters[i]->getEntity()->GetComponent<cmp::AdvancedBody>();
+  // The engine has removed the dudes stomped this frame by the next one
+  stompedDudes.clear();
 
-    if(characters[i]->getSlimeBag().size() == 5 && RNG::Integer(0, 10) == 10)
-      MakeSquishParticle(7.0f, trans->GetPosition());
-    
-    //inform the cam manager that this is an important object
-    CamManager::DynamicPing(trans->GetPosition() + 0.5f * body->GetVelocity(), 5 - GetPlayerCount());
+  FlushEffects();
+}
 
-    // Update the punch cooldown
-    if (characters[i]->GetPunchTimer() > 0)
-    {
-      characters[i]->TickPunchTimer(Time::GetDT());
-    }
+void CharacterManager::Tick(float dt)
+{
+  // Effects are recorded while simulating and sent out together at the end of Update
+  CharacterSink& effects = GetSink();
 
-    // Vibrate the controller if the character is stunned
-    if (!characters[i]->canMove())
-    {
-      ControllerManager::GetController(i)->VibrateController(0.0f, 1.0f, 0.2f);
-    }
+  // A replay can override the timestep along with the input
+  frameDt = dt;
+  CharacterReplay::BeginFrame(frameDt, commands);
 
-    //if moving upwards, pass through platforms
-    if (body->GetVelocity().y > 0)
-    {
-      characters[i]->passThrough_ = true;
-    }
+  // Act on every input submitted since the last update
+  DispatchCommands();
+
+  // Update the punch cooldowns in one pass over the state table
+  states.TickPunchTimers(frameDt);
+
+  // Resolve every punch thrown since the last update as one batch
+  ResolvePunches();
+
+  // Read phase: the engine makes no promises about threads, so every query into it happens here
+  GatherContacts();
+
+  // Compute phase: only the copied out results and the state table, spread over the workers
+  JobSystem::ParallelFor(static_cast<int>(characters.size()), UPDATE_GRAIN, ComputeCharacters);
+
+  // Effects recorded by the workers go out in character order, however the work was split
+  BufferedCharacterSink::ReplayInOrder(workerEffects.data(), static_cast<int>(workerEffects.size()), effects);
+
+  // Characters are folded into the checksum as the apply phase finishes with them
+  checksum.Begin(frame);
+
+  // Apply phase: everything that writes shared state, serially and in ID order
+  for (int i = 0; i < characters.size(); i++)
+  {
+    const std::shared_ptr<cmp::Transform>& trans = characters[i].getTransform();
+    const std::shared_ptr<cmp::AdvancedBody>& body = characters[i].getBody();
+
+    if(states.slimeBag[i].IsFull() && RandomInteger(0, 10) == 10)
+      effects.Particle(SquishParticle, 7.0f, trans->GetPosition());
 
-    // If passThrough_ is true, don't check for fall-through platforms
-    if(characters[i]->passThrough_)
+    // If the character can pass through, don't check for fall-through platforms
+    if(states.HasFlag(i, PassThroughFlag))
     {
       CollisionLayer layer(user, world);
       body->SetLayer(layer);
@@ -171,135 +276,108 @@ void CharacterManager::Update()
       body->SetLayer(layer);
     }
 
-    // Check zone collider
-    //CollisionResult result = PhysicsManager::RunCollision(*characters[i]->getZoneCollider());
-    CollisionResult result = body->RunDetection(Layer::goal, cmp::AdvancedDetectors::BODY);
-    bool correct = false;
+    // Filled in by GatherContacts
+    CharacterContacts& contact = contacts[i];
 
-    if(result.collision && Time::GetScaledDT())
+    // GatherContacts has already checked that this is the zone that is turned on
+    if (inGoal[i])
     {
-      unsigned counter = 0;
-      unsigned size = result.numCollisions;
-      while(counter < size)
+      //Check for any slimes to drop off
+      if (states.slimeBag[i].Weight())
       {
-        //Make sure you are colliding with the zone that is turned on
-        EntityPtr zone = result.boxCollisions[counter]->GetParent().lock();
+        // Bigger vibration the more slimes you have (continuous)
+        effects.Vibrate(i, 0.2f * states.slimeBag[i].Weight(), 0.0f, 0.1f);
 
-        std::pair<unsigned, unsigned> currentZone = DudeAI::getCurrentZone();
-
-        if (currentZone.first == DudeAI::getZoneId(zone))
+        if (states.zoneTimer[i] > 0)
         {
-          correct = true;
-          break;
+          states.zoneTimer[i] -= frameDt;
         }
-        counter++;
-      }
 
-      if(correct)
-      {
-        //Check for any slimes to drop off
-        if (characters[i]->getSlimeBagWeight())
+        if(states.zoneTimer[i] <= 0)
         {
-          // Bigger vibration the more slimes you have (continuous)
-          ControllerManager::GetController(i)->VibrateController(0.2f * characters[i]->getSlimeBagWeight(), 0.0f, 0.1f);
-
-          if (characters[i]->getZoneTimer() > 0)
-          {
-            characters[i]->tickZoneTimer(Time::GetDT());
-          }
-
-          if(characters[i]->getZoneTimer() <= 0)
-          {
-              characters[i]->setZoneTimer(1.0f);
-              int score = characters[i]->popSlime();
-              if(score == 5)
-              {
-                evt::EventManager::GetCharacterEventSubject().Notify(evt::CharacterEvent(nullptr, evt::slimeGold));
-              }
-              else
-              {
-                evt::EventManager::GetCharacterEventSubject().Notify(evt::CharacterEvent(nullptr, evt::slimeDeliver));
-              }
-              if (i == 0)
-                Score::AddScore(score, Score::player1);
-              else if(i == 1)
-                Score::AddScore(score, Score::player2);
-              else if (i == 2)
-                Score::AddScore(score, Score::player3);
-              else if (i == 3)
-                Score::AddScore(score, Score::player4);
-
-              if (int weight = characters[i]->getSlimeBagWeight())
-              {
-                PopupNumber::Make(weight, PopupText::TeamColors[i], characters[i]->getEntity()->GetComponent<cmp::Transform>()->GetPosition(), 3.0f, 1.0f);
-                ScreenspacePopupText::Make(std::to_string(weight), PopupText::TeamColors[i], { -0.8 + i * 1.6 / 3, -0.5 }, 0, 1.0f, true, i);
-                // Bigger vibration the more slimes you have (pulse)
-                //ControllerManager::GetController(i)->VibrateController(0.2f * weight, 0.0f, 0.1f);
-              }
-              else
-              {
-                PopupText::Make("EMPTY!", PopupText::UI_ColorRed, characters[i]->getEntity()->GetComponent<cmp::Transform>()->GetPosition(), 3.0f, 1.0f, true);
-                ScreenspacePopupText::Make("EMPTY!", PopupText::UI_ColorRed, { -0.8 + i * 1.6 / 3, -0.5 }, 0, 1.0f, true, i);
-                //MakeSquishParticle(5, )
-
-                // Stop vibrating the controller when there's nothing left to turn in
-                ControllerManager::GetController(i)->StopVibration();
-              }
-          }
-          else if (characters[i]->getZoneTimer() <= 0)
-          {
-            characters[i]->setZoneTimer(1.0f);
-            PopupText::Make("EMPTY!", PopupText::UI_ColorRed, characters[i]->getEntity()->GetComponent<cmp::Transform>()->GetPosition(), 3.0f, 1.0f);
-          }
+            states.zoneTimer[i] = 1.0f;
+            int score = characters[i].popSlime();
+            if(score == SLIME_GOLDEN_WEIGHT)
+            {
+              events.Push(i, evt::CharacterEvent(nullptr, evt::slimeGold));
+            }
+            else
+            {
+              events.Push(i, evt::CharacterEvent(nullptr, evt::slimeDeliver));
+            }
+            Score::AddScore(score, scoreSlots[GetSlot(i)]);
+
+            if (int weight = states.slimeBag[i].Weight())
+            {
+              effects.DeliveryPopup(i, weight, trans->GetPosition());
+              // Bigger vibration the more slimes you have (pulse)
+              //ControllerManager::GetController(i)->VibrateController(0.2f * weight, 0.0f, 0.1f);
+            }
+            else
+            {
+              effects.EmptyPopup(i, trans->GetPosition(), true);
+              //MakeSquishParticle(5, )
+
+              // Stop vibrating the controller when there's nothing left to turn in
+              effects.StopVibration(i);
+            }
+        }
+        else if (states.zoneTimer[i] <= 0)
+        {
+          states.zoneTimer[i] = 1.0f;
+          effects.EmptyPopup(i, trans->GetPosition(), false);
         }
       }
     }
 
     //Check top collider
-    result = body->RunDetection(world, cmp::TOP);
-    if (result.collision)
+    if (contact.Has(WorldTop))
     {
-      characters[i]->addLimiter();
+      states.SetFlag(i, TerminalVelocityFlag, true);
     }
 
     //Check left collider
-    result = body->RunDetection(world, cmp::LEFT);
-    if (result.collision)
+    if (contact.Has(WorldLeft))
     {
-      characters[i]->setHit(false);
-      auto body = characters[i]->getEntity()->GetComponent<cmp::AdvancedBody>();
-      characters[i]->removeLimiter();
+      states.SetFlag(i, IsHitFlag, false);
+      states.SetFlag(i, TerminalVelocityFlag, false);
     }
 
     //Check right collider
-    result = body->RunDetection(world, cmp::RIGHT);
-    if (result.collision)
+    if (contact.Has(WorldRight))
+    {
+      states.SetFlag(i, IsHitFlag, false);
+      states.SetFlag(i, TerminalVelocityFlag, false);
+    }
+
+    // The queries ran before anyone stomped, so once a slime is gone its colliders may be stale or reused
+    if (!stompedDudes.empty())
     {
-      characters[i]->setHit(false);
-      auto body = characters[i]->getEntity()->GetComponent<cmp::AdvancedBody>();
-      characters[i]->removeLimiter();
+      contact.Invalidate(CONTACT_BIT(SlimeBottom));
+      contact.Query(*body, CONTACT_BIT(SlimeBottom), contactArena);
     }
 
     //Check bottom collider
-    result = body->RunDetection(slime, cmp::BOTTOM);
-    if (result.collision)
+    if (contact.Has(SlimeBottom))
     {
       bool hitAlien = false;
 
       // Run through the box collisions, see what gets hit
-      for (int j = 0; j < 5; j++)
+      for (const BoxCollider* collider : contact.Colliders(SlimeBottom))
       {
-        const BoxCollider* collider = result.boxCollisions[j];
+        std::shared_ptr<Entity> entity = collider->GetParent().lock();
 
-        if (collider /* && body->GetVelocity().y <= 0 */)
+        // A destroyed dude can keep its collider until the engine removes it, so it could be picked up twice
+        if (!entity || std::find(stompedDudes.begin(), stompedDudes.end(), entity) != stompedDudes.end())
         {
-          std::shared_ptr<Entity> entity = collider->GetParent().lock();
+          continue;
+        }
 
-          if (entity->GetName() == "aliendude" || entity->GetName() == "aliengolden")
-          {
-            hitAlien = true;
-            DudeAI::DestroyDude(entity, characters[i], user);
-          }
+        if (entity->GetName() == "aliendude" || entity->GetName() == "aliengolden")
+        {
+          hitAlien = true;
+          stompedDudes.push_back(entity);
+          DudeAI::DestroyDude(entity, &characters[i], user);
         }
       }
 
@@ -309,14 +387,14 @@ void CharacterManager::Update()
         body->SetVelocity(vec2(body->GetVelocity().x, fmaxf(0.0f, body->GetVelocity().y) + Character::GetJumpSpeed() / BOUNCE_MODIFIER));
 
         // Show a slime effect
-        MakeJumpParticle(2.0f / 5.0f, CharacterManager::GetCharacter(i)->getEntity()->GetComponent<cmp::Transform>()->GetPosition());
+        effects.Particle(JumpParticle, 2.0f / 5.0f, trans->GetPosition());
 
         // Bigger vibration the more slimes you have
-        ControllerManager::GetController(i)->VibrateController(0.2f * characters[i]->getSlimeBagWeight(), 0.0f, 0.15f);
+        effects.Vibrate(i, 0.2f * states.slimeBag[i].Weight(), 0.0f, 0.15f);
 
         // Hopping off of a slime will count as your first jump from the ground
-        characters[i]->setFirstJump(true);
-        characters[i]->setJump(true);
+        states.SetFlag(i, FirstJumpFlag, true);
+        states.SetFlag(i, CanJumpFlag, true);
       }
     }
     
@@ -351,8 +429,8 @@ void CharacterManager::Update()
         ControllerManager::GetController(i)->VibrateController(0.2f, 0.0f, 0.15f);
 
         // Hopping off of a slime will count as your first jump from the ground
-        characters[i]->setFirstJump(true);
-        characters[i]->setJump(true);
+        states.SetFlag(i, FirstJumpFlag, true);
+        states.SetFlag(i, CanJumpFlag, true);
       }
     }
     */
@@ -360,34 +438,25 @@ void CharacterManager::Update()
     bool touch = false;
 
     // Check for floor collision
-    result = body->RunDetection(world, cmp::BOTTOM);
-    if (result.collision)
+    if (contact.Has(WorldBottom))
     {
       touch = true;
     }
 
     // If the character should not pass through platforms, check for platform collisions
-    if (!characters[i]->passThrough_)
+    if (contact.Has(GhostBottom))
     {
-      // Check for platform collision
-      result = body->RunDetection(ghost, cmp::BOTTOM);
-      if (result.collision)
-      {
-        touch = true;
-      }
-
+      touch = true;
     }
 
     if (touch)
     {
       // Set values only when character starts touching the floor (not continuous)
-      if (!characters[i]->isOnFloor()) // && !characters[i]->passThrough_)
+      if (!states.HasFlag(i, OnFloorFlag)) // && !states.HasFlag(i, PassThroughFlag))
       {
-        auto trans = characters[i]->getEntity()->GetComponent<cmp::Transform>();
-
         vec2 pos = trans->GetPosition() - vec2(0, (trans->GetScale().y / 2));
 
-        MakeLandingParticle(3.0f, pos, false);
+        effects.Particle(LandingParticle, 3.0f, pos, false);
 
         // Turn off gravity
         body->SetAcceleration(vec2(0.0f, 0.0f));
@@ -395,50 +464,233 @@ void CharacterManager::Update()
         
 
         // The character is now on the floor
-        characters[i]->setOnFloor(true);
+        states.SetFlag(i, OnFloorFlag, true);
 
         // The character is set to double-jump again
-        characters[i]->setFirstJump(false);
+        states.SetFlag(i, FirstJumpFlag, false);
 
         // The character can move again if they were hit-stunned
-        characters[i]->setHit(false);
+        states.SetFlag(i, IsHitFlag, false);
 
         // Character can hop around while holding the jump button
-        characters[i]->removeLimiter();
+        states.SetFlag(i, TerminalVelocityFlag, false);
       }
     }
     else
     {
       // If we were touching the floor but aren't anymore, turn gravity back on
-      if (characters[i]->isOnFloor())
+      if (states.HasFlag(i, OnFloorFlag))
       {
         // Turn on gravity
         body->SetAcceleration(vec2(0.0f, Character::GetGravity()));
 
         // The character is no longer on the floor
-        characters[i]->setOnFloor(false);
+        states.SetFlag(i, OnFloorFlag, false);
 
         // Character can double-jump in the air
-        characters[i]->setJump(true);
+        states.SetFlag(i, CanJumpFlag, true);
 
         // If the character walks off the platform, they can double-jump
         if (body->GetVelocity().y <= 0)
         {
-          characters[i]->setFirstJump(true);
+          states.SetFlag(i, FirstJumpFlag, true);
         }
       }
     }
+
+    // Bodies move before the next frame, so this frame's contacts are stale after this point
+    contact.Invalidate();
+
+    checksum.Add(i, states, trans->GetPosition(), body->GetVelocity());
+  }
+
+  checksum.End();
+
+  // Every span handed out this frame is dead now
+  contactArena.Reset();
+
+  if (CharacterReplay::IsRecording() || CharacterReplay::IsPlaying())
+  {
+    CharacterReplay::EndFrame(checksum.Get());
   }
+
+  if (keepSnapshots)
+  {
+    SaveSnapshot(history[frame % SNAPSHOT_HISTORY]);
+  }
+
+  // Two landings in two ticks are two landings, events are only merged within the tick they came from
+  events.EndTick();
+
+  ++frame;
+}
+
+void CharacterManager::FlushEffects()
+{
+  // Observers (audio, fist animations) run here, once the simulation is done with the frame
+  events.Flush(*sink);
+
+  // Then the frame's effects, grouped so each effects system gets its work in one run
+  frameEffects.ReplayByType(*sink);
+  sink->Flush();
+}
+
+void CharacterManager::GatherContacts()
+{
+  // Zones only change between frames, so look the active one up once
+  std::pair<unsigned, unsigned> currentZone = DudeAI::getCurrentZone();
+
+  for (int i = 0; i < characters.size(); ++i)
+  {
+    const std::shared_ptr<cmp::AdvancedBody>& body = characters[i].getBody();
+    bodyPosition[i] = characters[i].getTransform()->GetPosition();
+    bodyVelocity[i] = body->GetVelocity();
+
+    // Run every contact check for this frame in one sweep, skipping platforms we can pass through.
+    // Moving upwards passes through them too, the compute phase sets the flag to match.
+    CharacterContacts& contact = contacts[i];
+    ContactMask wanted = ALL_CONTACTS;
+
+    if (states.HasFlag(i, PassThroughFlag) || bodyVelocity[i].y > 0)
+    {
+      wanted &= ~CONTACT_BIT(GhostBottom);
+    }
+
+    contact.Query(*body, wanted, contactArena);
+
+    // Check zone collider
+    //CollisionResult result = PhysicsManager::RunCollision(*characters[i].getZoneCollider());
+    bool correct = false;
+
+    if(contact.Has(GoalBody) && frameDt > 0)
+    {
+      for (const BoxCollider* collider : contact.Colliders(GoalBody))
+      {
+        //Make sure you are colliding with the zone that is turned on
+        EntityPtr zone = collider->GetParent().lock();
+
+        if (zone && currentZone.first == DudeAI::getZoneId(zone))
+        {
+          correct = true;
+          break;
+        }
+      }
+    }
+
+    inGoal[i] = correct;
+  }
+}
+
+void CharacterManager::ComputeCharacters(int begin, int end, int worker)
+{
+  BufferedCharacterSink& effects = workerEffects[worker];
+
+  // Headless runs drop every effect, so don't bother recording them
+  bool recordEffects = sink != &nullSink;
+
+  for (int i = begin; i < end; ++i)
+  {
+    if (recordEffects)
+    {
+      effects.SetKey(i);
+
+      //inform the cam manager that this is an important object
+      effects.CameraPing(bodyPosition[i] + 0.5f * bodyVelocity[i], std::max(1, 5 - GetPlayerCount()));
+
+      // Vibrate the controller if the character is stunned
+      if (states.HasFlag(i, IsHitFlag))
+      {
+        effects.Vibrate(i, 0.0f, 1.0f, 0.2f);
+      }
+    }
+
+    //if moving upwards, pass through platforms (each job only writes its own characters' flags)
+    if (bodyVelocity[i].y > 0)
+    {
+      states.SetFlag(i, PassThroughFlag, true);
+    }
+  }
+}
+
+void CharacterManager::DispatchCommands()
+{
+  if (commands.empty())
+  {
+    return;
+  }
+
+  for (const InputCommand& command : commands)
+  {
+    // Characters can be shut down while their inputs are still in flight
+    if (command.character >= characters.size())
+    {
+      continue;
+    }
+
+    intents[command.character].Add(command);
+  }
+
+  for (unsigned i = 0; i < characters.size(); ++i)
+  {
+    if (intents[i].active)
+    {
+      characters[i].resolveIntent(intents[i]);
+      intents[i] = CharacterIntent();
+    }
+  }
+
+  commands.clear();
+}
+
+void CharacterManager::ResolvePunches()
+{
+  if (punches.empty())
+  {
+    return;
+  }
+
+  std::stable_sort(punches.begin(), punches.end(), [](const PunchRequest& a, const PunchRequest& b)
+  {
+    return a.attacker < b.attacker;
+  });
+
+  // Query every hitbox before anyone is knocked back, so all punches see the same world
+  for (PunchRequest& punch : punches)
+  {
+    punch.hits = characters[punch.attacker].queryPunch(punch.direction, contactArena);
+  }
+
+  for (const PunchRequest& punch : punches)
+  {
+    characters[punch.attacker].resolvePunch(punch.direction, punch.hits);
+  }
+
+  punches.clear();
 }
 
 void CharacterManager::Shutdown()
 {
-  for(auto iter = characters.begin(); iter != characters.end(); ++iter)
+  for (unsigned i = 0; i < characters.size(); ++i)
   {
-    delete *iter;
+    characters[i].destroyPunchHitboxes();
   }
 
   characters.clear();
+  punches.clear();
+  commands.clear();
+  stompedDudes.clear();
+  events.Clear();
+  frameEffects.Clear();
+  states.Clear();
+  TargetRegistry::Clear();
+  CharacterEventRouter::Clear();
+
+#ifndef FB_HEADLESS
+  SquashPool::Clear();
+
+  // The device thread talks to the controllers, so it has to stop before the engine tears them down
+  HapticsScheduler::Shutdown();
+#endif
 
   // Characters are no longer active, do not execute character-related actions
   isActive = false;
@@ -472,7 +724,7 @@ bool CharacterManager::LoadGlobals(std::string filename)
     return false;
   }
 
-  // Load the global values
+  // Load the global values, fixed point builds convert the speeds here and never again
   Character::SetAcceleration((*jsonGlobal)["acceleration"].GetFloat());
   Character::SetJumpSpeed((*jsonGlobal)["jumpspeed"].GetFloat());
   Character::SetMaxSpeed((*jsonGlobal)["maxspeed"].GetFloat());
@@ -512,12 +764,60 @@ void CharacterManager::RemoveFromEntityManager()
 
 void CharacterManager::AttachEntity(int id, std::shared_ptr<fb::Entity> entity)
 {
-  characters[id]->attachEntity(entity);
+  // Punches look their targets up by entity, so the registry has to move along with the character
+  TargetRegistry::Unregister(characters[id].getEntity().get());
+  characters[id].attachEntity(entity);
+  TargetRegistry::Register(entity.get(), TargetCharacter, id);
+
+  // Contacts gathered on the old entity don't apply to the new one
+  contacts[id].Invalidate();
+}
+
+CharacterContacts& CharacterManager::GetContacts(int id)
+{
+  return contacts[id];
+}
+
+ContactArena& CharacterManager::GetContactArena()
+{
+  return contactArena;
+}
+
+void CharacterManager::QueuePunch(int attacker, Direction direction)
+{
+  PunchRequest punch;
+  punch.attacker = attacker;
+  punch.direction = direction;
+  punch.hits.data = nullptr;
+  punch.hits.count = 0;
+
+  punches.push_back(punch);
+}
+
+void CharacterManager::SubmitInput(int character, InputVerb verb, Direction direction)
+{
+  InputCommand command;
+  command.frame = frame;
+  command.character = static_cast<uint16_t>(character);
+  command.verb = verb;
+  command.direction = static_cast<uint8_t>(direction);
+
+  commands.push_back(command);
+}
+
+void CharacterManager::SubmitCommand(const InputCommand& command)
+{
+  commands.push_back(command);
+}
+
+uint32_t CharacterManager::GetFrame()
+{
+  return frame;
 }
 
 Character* CharacterManager::GetCharacter(int id)
 {
-  return characters[id];
+  return &characters[id];
 }
 
 DocumentPtr CharacterManager::GetJsonGlobal()
@@ -532,14 +832,14 @@ bool CharacterManager::Active()
 
 void CharacterManager::SetCharacterPosition(int id, vec2 position)
 {
-  characters[id]->getEntity()->GetComponent<cmp::Transform>()->SetPosition(position);
+  characters[id].getTransform()->SetPosition(position);
 }
 
 void CharacterManager::ResetSlimeBags()
 {
   for (int i = 0; i < characters.size(); i++)
   {
-    characters[i]->clearSlimeBagWeight();
+    characters[i].clearSlimeBagWeight();
   }
 }
 
@@ -552,3 +852,156 @@ int CharacterManager::GetPlayerCount()
 {
   return characters.size();
 }
+
+
+CharacterStateTable& CharacterManager::GetStateTable()
+{
+  return states;
+}
+
+void CharacterManager::SetSink(CharacterSink* newSink)
+{
+  sink = newSink ? newSink : &nullSink;
+}
+
+uint32_t CharacterManager::GetRandomState()
+{
+  return randomState;
+}
+
+void CharacterManager::SetRandomState(uint32_t state)
+{
+  // Xorshift gets stuck on zero
+  randomState = state ? state : 1;
+}
+
+int CharacterManager::RandomInteger(int min, int max)
+{
+  // Xorshift32, so a replay only has to store one number to get the same rolls
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+
+  return min + static_cast<int>(randomState % static_cast<uint32_t>(max - min + 1));
+}
+
+uint64_t CharacterManager::GetChecksum()
+{
+  return checksum.Get();
+}
+
+uint64_t CharacterManager::GetCharacterChecksum(int id)
+{
+  return checksum.GetCharacter(id);
+}
+
+void CharacterManager::SetChecksumLog(std::ostream* stream)
+{
+  checksum.SetLog(stream);
+}
+
+void CharacterManager::SaveSnapshot(CharacterSnapshot& snapshot)
+{
+  int count = static_cast<int>(characters.size());
+
+  snapshot.frame = frame;
+  snapshot.randomState = randomState;
+  snapshot.count = count;
+
+  // The table is laid out as arrays, so each one is a single copy
+  std::copy(states.flags, states.flags + count, snapshot.flags);
+  std::copy(states.punchTimer, states.punchTimer + count, snapshot.punchTimer);
+  std::copy(states.zoneTimer, states.zoneTimer + count, snapshot.zoneTimer);
+  std::copy(states.slimeBag, states.slimeBag + count, snapshot.slimeBag);
+
+  for (int i = 0; i < count; ++i)
+  {
+    const std::shared_ptr<cmp::AdvancedBody>& body = characters[i].getBody();
+    snapshot.position[i] = characters[i].getTransform()->GetPosition();
+    snapshot.velocity[i] = body->GetVelocity();
+    snapshot.acceleration[i] = body->GetAcceleration();
+  }
+}
+
+void CharacterManager::LoadSnapshot(const CharacterSnapshot& snapshot)
+{
+  int count = std::min(snapshot.count, static_cast<int>(characters.size()));
+
+  std::copy(snapshot.flags, snapshot.flags + count, states.flags);
+  std::copy(snapshot.punchTimer, snapshot.punchTimer + count, states.punchTimer);
+  std::copy(snapshot.zoneTimer, snapshot.zoneTimer + count, states.zoneTimer);
+  std::copy(snapshot.slimeBag, snapshot.slimeBag + count, states.slimeBag);
+
+  for (int i = 0; i < count; ++i)
+  {
+    const std::shared_ptr<cmp::AdvancedBody>& body = characters[i].getBody();
+    characters[i].getTransform()->SetPosition(snapshot.position[i]);
+    body->SetVelocity(snapshot.velocity[i]);
+    body->SetAcceleration(snapshot.acceleration[i]);
+
+    contacts[i].Invalidate();
+  }
+
+  // Anything queued belongs to the timeline being thrown away
+  commands.clear();
+  punches.clear();
+  events.Clear();
+  frameEffects.Clear();
+
+  // The restored flags skip Character::face, so the sprites would keep facing the old way
+  ShowFacing();
+
+  randomState = snapshot.randomState;
+  frame = snapshot.frame + 1;
+}
+
+void CharacterManager::KeepSnapshots(bool enable)
+{
+  // Mark every slot empty so nothing from an earlier run can be restored
+  for (CharacterSnapshot& snapshot : history)
+  {
+    snapshot.frame = UINT32_MAX;
+  }
+
+  keepSnapshots = enable;
+}
+
+bool CharacterManager::RestoreFrame(uint32_t target)
+{
+  const CharacterSnapshot& snapshot = history[target % SNAPSHOT_HISTORY];
+
+  // The slot may have been overwritten by a later frame, or never filled
+  if (!keepSnapshots || snapshot.frame != target || target >= frame)
+  {
+    return false;
+  }
+
+  LoadSnapshot(snapshot);
+  return true;
+}
+
+void CharacterManager::ShowFacing()
+{
+  CharacterSink& effects = GetSink();
+
+  for (int i = 0; i < static_cast<int>(characters.size()); ++i)
+  {
+    effects.Face(i, states.HasFlag(i, FacingLeftFlag));
+  }
+}
+
+CharacterSink& CharacterManager::GetSink()
+{
+  // Nothing to record if every effect would be dropped anyway
+  if (sink == &nullSink)
+  {
+    return nullSink;
+  }
+
+  return frameEffects;
+}
+
+void CharacterManager::QueueEvent(int character, const evt::CharacterEvent& event)
+{
+  events.Push(character, event);
+}
\ No newline at end of file
@@ -11,31 +11,74 @@
 #pragma once
 
 #include "Character.h"
+#include "CharacterContacts.h"
+#include "CharacterSink.h"
+#include "BufferedCharacterSink.h"
+#include "CharacterEventQueue.h"
+#include "StringTable.h"
+#include "CharacterSnapshot.h"
+#include "CharacterChecksum.h"
+#include "InputCommand.h"
 #include "Entity.h"
-#include "glm\vec2.hpp"
+#include "glm/vec2.hpp"
 #include "EntityManager.h"
 #include <vector>
 
+#define PLAYER_SLOTS 4 //!< How many archetypes, fist colours, score slots and HUD slots there are
 
 namespace fb
 {
+  //! A punch waiting to be resolved in CharacterManager::Update
+  struct PunchRequest
+  {
+    int attacker;        //!< ID of the character that punched
+    Direction direction; //!< Direction the punch was thrown in
+    ContactSpan hits;    //!< What the punch hit, filled in when the batch is resolved
+  };
+
   class CharacterManager
   {
     public:
       /*!
       *******************************************************************************
-      \brief   Initialize the Character list
+      \brief   Initialize the Character list, one character per controller, and
+               send side effects to the engine
       \return  None (void).
       *******************************************************************************/
       static void Init();
 
       /*!
       *******************************************************************************
-      \brief   Update the Character attributes
+      \brief   Initialize the Character list with a set number of characters.
+               Leaves the current sink alone, so headless runs can call this
+               directly. Seeds the random number generator from the clock, so
+               a replay has to be started after this for its seed to stick.
+      \param   count
+        How many characters to create (int).
+      \return  None (void).
+      *******************************************************************************/
+      static void Init(int count);
+
+      /*!
+      *******************************************************************************
+      \brief   Update the Character attributes. Runs one tick with the frame's
+               time, since the engine moves the bodies once per frame, then
+               sends out its effects.
       \return  None (void).
       *******************************************************************************/
       static void Update();
 
+      /*!
+      *******************************************************************************
+      \brief   Runs one tick with the given timestep and sends out its effects.
+               For tools and benchmarks that need to step the simulation
+               themselves.
+      \param   dt
+        Length of the tick (float).
+      \return  None (void).
+      *******************************************************************************/
+      static void Step(float dt);
+
       /*!
       *******************************************************************************
       \brief   Clear the Character list. DOES NOT delete attached entities.
@@ -68,7 +111,8 @@ namespace fb
 
       /*!
       *******************************************************************************
-      \brief   Attach an entity to the specified character
+      \brief   Attach an entity to the specified character. The character's punch
+               hitboxes and punch target registration move to the new entity.
       \param   id
         The ID to check for (int).
       \param   entity
@@ -86,6 +130,147 @@ namespace fb
       *******************************************************************************/
       static Character* GetCharacter(int id);
 
+      /*!
+      *******************************************************************************
+      \brief   Get the batched contact results of a character for this frame
+      \param   id
+        The ID to check for (int).
+      \return  The character's contacts (CharacterContacts &).
+      *******************************************************************************/
+      static CharacterContacts& GetContacts(int id);
+
+      /*!
+      *******************************************************************************
+      \brief   Get the arena contact lists are stored in for the current frame
+      \return  The frame's contact arena (ContactArena &).
+      *******************************************************************************/
+      static ContactArena& GetContactArena();
+
+      /*!
+      *******************************************************************************
+      \brief   Queues a punch to be resolved with every other punch this frame
+      \param   attacker
+        ID of the character that punched (int).
+      \param   direction
+        Direction the punch was thrown in (Direction).
+      \return  None (void).
+      *******************************************************************************/
+      static void QueuePunch(int attacker, Direction direction);
+
+      /*!
+      *******************************************************************************
+      \brief   Writes an input for a character into this frame's command buffer
+      \param   character
+        ID of the character the input is for (int).
+      \param   verb
+        What the character should do (InputVerb).
+      \param   direction
+        Which way the character should do it (Direction).
+      \return  None (void).
+      *******************************************************************************/
+      static void SubmitInput(int character, InputVerb verb, Direction direction);
+
+      /*!
+      *******************************************************************************
+      \brief   Writes an already built command into this frame's command buffer
+      \param   command
+        The command to add (const InputCommand &).
+      \return  None (void).
+      *******************************************************************************/
+      static void SubmitCommand(const InputCommand& command);
+
+      /*!
+      *******************************************************************************
+      \brief   Get the number of the tick currently being simulated
+      \return  The tick number (uint32_t).
+      *******************************************************************************/
+      static uint32_t GetFrame();
+
+      /*!
+      *******************************************************************************
+      \brief   Get the state of the random number generator used by Update
+      \return  The generator state (uint32_t).
+      *******************************************************************************/
+      static uint32_t GetRandomState();
+
+      /*!
+      *******************************************************************************
+      \brief   Set the state of the random number generator used by Update, so
+               the same rolls come out again
+      \param   state
+        The generator state, 0 is replaced with 1 (uint32_t).
+      \return  None (void).
+      *******************************************************************************/
+      static void SetRandomState(uint32_t state);
+
+      /*!
+      *******************************************************************************
+      \brief   Get the checksum of every character's simulation state (flags,
+               timers, slime bags, positions and velocities) at the end of the
+               last tick
+      \return  The checksum (uint64_t).
+      *******************************************************************************/
+      static uint64_t GetChecksum();
+
+      /*!
+      *******************************************************************************
+      \brief   Get the hash of one character's simulation state at the end of the
+               last tick, to find which character a checksum mismatch came from
+      \param   id
+        ID of the character (int).
+      \return  The character's hash (uint64_t).
+      *******************************************************************************/
+      static uint64_t GetCharacterChecksum(int id);
+
+      /*!
+      *******************************************************************************
+      \brief   Sets a stream to write every frame's checksum to, one
+               "tick checksum" line per tick
+      \param   stream
+        Where to write, or NULL to stop logging (std::ostream *).
+      \return  None (void).
+      *******************************************************************************/
+      static void SetChecksumLog(std::ostream* stream);
+
+      /*!
+      *******************************************************************************
+      \brief   Copies the simulation state of every character into a snapshot
+      \param   snapshot
+        Where to save the state (CharacterSnapshot &).
+      \return  None (void).
+      *******************************************************************************/
+      static void SaveSnapshot(CharacterSnapshot& snapshot);
+
+      /*!
+      *******************************************************************************
+      \brief   Puts every character back the way a snapshot saw them. Input,
+               punches and effects waiting for the next Update are dropped, and
+               the next Update simulates the frame after the snapshot's.
+      \param   snapshot
+        The state to restore, taken with the same characters (const CharacterSnapshot &).
+      \return  None (void).
+      *******************************************************************************/
+      static void LoadSnapshot(const CharacterSnapshot& snapshot);
+
+      /*!
+      *******************************************************************************
+      \brief   Turns on keeping a snapshot of the last SNAPSHOT_HISTORY frames,
+               taken at the end of every Update
+      \param   enable
+        Whether or not to keep snapshots (bool).
+      \return  None (void).
+      *******************************************************************************/
+      static void KeepSnapshots(bool enable);
+
+      /*!
+      *******************************************************************************
+      \brief   Rolls back to the end of a recent frame
+      \param   frame
+        The frame to go back to (uint32_t).
+      \return  True if that frame is still in the history, false otherwise (bool).
+      *******************************************************************************/
+      static bool RestoreFrame(uint32_t frame);
+
 
       /*!
       *******************************************************************************
@@ -117,9 +302,173 @@ namespace fb
       static void SetActive(bool);
       static int GetPlayerCount();
 
+      /*!
+      *******************************************************************************
+      \brief   Get the player slot a character uses for its archetype, colours,
+               score and HUD. Characters past the last slot share them in turn.
+      \param   id
+        ID of the character (int).
+      \return  The character's slot, from 0 to PLAYER_SLOTS - 1 (int).
+      *******************************************************************************/
+      static int GetSlot(int id) { return id % PLAYER_SLOTS; }
+
+      /*!
+      *******************************************************************************
+      \brief   Get the name of the slime trail a character's dropped slimes
+               follow, made once in Init
+      \param   id
+        ID of the character (int).
+      \return  The trail name (const std::string &).
+      *******************************************************************************/
+      static const std::string& GetTrailName(int id) { return StringTable::Get(trailNames[id]); }
+
+      /*!
+      *******************************************************************************
+      \brief   Get the table holding the simulation state of every character
+      \return  The character state table (CharacterStateTable &).
+      *******************************************************************************/
+      static CharacterStateTable& GetStateTable();
+
+      /*!
+      *******************************************************************************
+      \brief   Sets where the characters send their rendering, audio, haptics
+               and popup side effects
+      \param   newSink
+        The sink to use, or NULL to drop every side effect (CharacterSink *).
+      \return  None (void).
+      *******************************************************************************/
+      static void SetSink(CharacterSink* newSink);
+
+      /*!
+      *******************************************************************************
+      \brief   Get the sink the characters send their side effects to. Effects
+               are recorded into the frame's effects buffer and sent to the sink
+               set with SetSink, grouped by type, at the end of Update. With no
+               sink set, nothing is recorded.
+      \return  Where to send side effects (CharacterSink &).
+      *******************************************************************************/
+      static CharacterSink& GetSink();
+
+      /*!
+      *******************************************************************************
+      \brief   Records a character event. Events are sent to the sink in one
+               batch at the end of Update, and repeats of the same event from
+               the same character in one frame are dropped.
+      \param   character
+        ID of the character the event is about, or -1 if it is not about one
+        character (int).
+      \param   event
+        The event to send (const evt::CharacterEvent &).
+      \return  None (void).
+      *******************************************************************************/
+      static void QueueEvent(int character, const evt::CharacterEvent& event);
+
   private:
-      static std::vector<Character*> characters;  //!< Holds the characters currently being played
+      /*!
+      *******************************************************************************
+      \brief   Simulates one tick: input, punches, contacts, zones and
+               velocities. Effects and events are left queued.
+      \param   dt
+        Length of the tick (float).
+      \return  None (void).
+      *******************************************************************************/
+      static void Tick(float dt);
+
+      /*!
+      *******************************************************************************
+      \brief   Sends out every queued event and effect, then flushes the sink
+      \return  None (void).
+      *******************************************************************************/
+      static void FlushEffects();
+
+      /*!
+      *******************************************************************************
+      \brief   Sends the facing flag of every character to the sink, for when the
+               flag was set without going through Character::face
+      \return  None (void).
+      *******************************************************************************/
+      static void ShowFacing();
+
+      /*!
+      *******************************************************************************
+      \brief   Resolves every queued punch. All hitboxes are queried first, then
+               hits are applied in attacker ID order, so the outcome does not
+               depend on the order the inputs arrived in.
+      \return  None (void).
+      *******************************************************************************/
+      static void ResolvePunches();
+
+      /*!
+      *******************************************************************************
+      \brief   Folds every command in the buffer into its character's intent, then
+               has each character act on its intent once, in ID order. Empties
+               the buffer.
+      \return  None (void).
+      *******************************************************************************/
+      static void DispatchCommands();
+
+      /*!
+      *******************************************************************************
+      \brief   Read phase of Update. Runs the contact queries and zone checks
+               for every character on the calling thread, and copies each
+               body's position and velocity out, so the compute phase never
+               has to call into the engine.
+      \return  None (void).
+      *******************************************************************************/
+      static void GatherContacts();
+
+      /*!
+      *******************************************************************************
+      \brief   Compute phase of Update for a range of characters. Works only
+               from what GatherContacts copied out and the state table, and
+               records side effects into the worker's buffer. Only writes state
+               owned by the characters in its range, so ranges can run on
+               different threads.
+      \param   begin
+        First character ID in the range (int).
+      \param   end
+        One past the last character ID in the range (int).
+      \param   worker
+        Index of the worker running the range (int).
+      \return  None (void).
+      *******************************************************************************/
+      static void ComputeCharacters(int begin, int end, int worker);
+
+      /*!
+      *******************************************************************************
+      \brief   Rolls a number with the character simulation's own generator
+      \param   min
+        Smallest number to roll (int).
+      \param   max
+        Largest number to roll (int).
+      \return  A number from min to max (int).
+      *******************************************************************************/
+      static int RandomInteger(int min, int max);
+
+      static std::vector<Character> characters;  //!< Handles for the characters currently being played
+      static CharacterStateTable states; //!< Simulation state of every character, indexed by ID
+      static CharacterContacts contacts[MAX_CHARACTERS]; //!< Contact results of every character, valid until the end of Update
+      static ContactArena contactArena; //!< Backing store for this frame's contact lists, rewound at the end of Update
+      static std::vector<PunchRequest> punches; //!< Punches thrown since the last Update
+      static std::vector<InputCommand> commands; //!< Inputs submitted since the last Update
+      static CharacterIntent intents[MAX_CHARACTERS]; //!< Inputs folded per character, only used while dispatching
+      static uint32_t frame; //!< Number of the frame currently being simulated
+      static float frameDt; //!< Timestep of the frame currently being simulated
+      static std::vector<EntityPtr> stompedDudes; //!< Slimes destroyed by a stomp this Update, kept alive so they are never picked up twice
+      static uint32_t randomState; //!< Xorshift state, seeded in Init and recorded in replays
+      static CharacterChecksum checksum; //!< Built up during the apply phase of every Update
+      static CharacterSnapshot history[SNAPSHOT_HISTORY]; //!< Ring of recent end-of-frame snapshots, indexed by frame
+      static bool keepSnapshots; //!< Whether or not Update fills the history
+      static bool inGoal[MAX_CHARACTERS]; //!< Whether each character is in the active zone, set by GatherContacts
+      static glm::vec2 bodyPosition[MAX_CHARACTERS]; //!< Position of each body when GatherContacts ran
+      static glm::vec2 bodyVelocity[MAX_CHARACTERS]; //!< Velocity of each body when GatherContacts ran
+      static std::vector<BufferedCharacterSink> workerEffects; //!< Side effects recorded by each worker during the compute phase
+      static CharacterEventQueue events; //!< Character events waiting for the end of Update
+      static StringId trailNames[MAX_CHARACTERS]; //!< Interned slime trail name of each character
+      static BufferedCharacterSink frameEffects; //!< Particles, popups, camera and rumble waiting for the end of Update
       static bool isActive; //!< Whether or not the characters are currently active in the gamestate
       static DocumentPtr jsonGlobal; //!< Holds the JSON for the global variables
+      static CharacterSink* sink; //!< Where side effects are sent, never NULL
+      static NullCharacterSink nullSink; //!< Used when no sink has been set
   };
 }
\ No newline at end of file
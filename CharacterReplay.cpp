@@ -0,0 +1,212 @@
+// Author:   James Liao
+// Copyright  2017 DigiPen (USA) Corporation.
+#include "CharacterReplay.h"
+#include "CharacterHandler.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+using namespace fb;
+
+// File layout, all values little endian:
+//   header: magic (u32), version (u16), characters (u16), random state (u32)
+//   frame:  dt (f32), command count (u16), commands (character u16, verb u8, direction u8), state checksum (u64)
+
+namespace
+{
+  std::ofstream output;                 // Open while recording
+  std::vector<char> input;              // Whole replay, while playing back
+  size_t cursor = 0;                    // Read position in input
+  bool recording = false;
+  bool playing = false;
+  int playbackFrame = 0;
+  int mismatchFrame = -1;
+
+  template <typename T>
+  void Write(const T& value)
+  {
+    output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  bool Read(T& value)
+  {
+    if (cursor + sizeof(T) > input.size())
+    {
+      return false;
+    }
+
+    std::memcpy(&value, &input[cursor], sizeof(T));
+    cursor += sizeof(T);
+    return true;
+  }
+}
+
+bool CharacterReplay::StartRecording(const std::string& path)
+{
+  StopRecording();
+
+  output.open(path, std::ios::binary | std::ios::trunc);
+
+  if (!output.is_open())
+  {
+    Logger::Msg("Failed to open replay for writing: " + path, Error);
+    return false;
+  }
+
+  Write(static_cast<uint32_t>(REPLAY_MAGIC));
+  Write(static_cast<uint16_t>(REPLAY_VERSION));
+  Write(static_cast<uint16_t>(CharacterManager::GetPlayerCount()));
+  Write(CharacterManager::GetRandomState());
+
+  recording = true;
+  return true;
+}
+
+void CharacterReplay::StopRecording()
+{
+  if (recording)
+  {
+    output.close();
+    recording = false;
+  }
+}
+
+bool CharacterReplay::StartPlayback(const std::string& path)
+{
+  StopPlayback();
+
+  std::ifstream file(path, std::ios::binary);
+
+  if (!file.is_open())
+  {
+    Logger::Msg("Failed to open replay: " + path, Error);
+    return false;
+  }
+
+  input.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  cursor = 0;
+
+  uint32_t magic = 0;
+  uint16_t version = 0;
+  uint16_t characters = 0;
+  uint32_t randomState = 0;
+
+  if (!Read(magic) || !Read(version) || !Read(characters) || !Read(randomState) || magic != REPLAY_MAGIC || version != REPLAY_VERSION)
+  {
+    Logger::Msg("Not a character replay: " + path, Error);
+    input.clear();
+    return false;
+  }
+
+  if (characters != CharacterManager::GetPlayerCount())
+  {
+    Logger::Msg("Replay was recorded with " + std::to_string(characters) + " characters, playing it back with " + std::to_string(CharacterManager::GetPlayerCount()));
+  }
+
+  CharacterManager::SetRandomState(randomState);
+
+  playbackFrame = 0;
+  mismatchFrame = -1;
+  playing = true;
+  return true;
+}
+
+void CharacterReplay::StopPlayback()
+{
+  playing = false;
+  input.clear();
+  cursor = 0;
+}
+
+bool CharacterReplay::IsRecording()
+{
+  return recording;
+}
+
+bool CharacterReplay::IsPlaying()
+{
+  return playing;
+}
+
+int CharacterReplay::GetMismatchFrame()
+{
+  return mismatchFrame;
+}
+
+void CharacterReplay::BeginFrame(float& dt, std::vector<InputCommand>& commands)
+{
+  if (playing)
+  {
+    // Live input is dropped, the recording is the only source of input
+    commands.clear();
+
+    float recordedDt = 0.0f;
+    uint16_t count = 0;
+
+    if (!Read(recordedDt) || !Read(count))
+    {
+      Logger::Msg("Replay finished after " + std::to_string(playbackFrame) + " frames");
+      StopPlayback();
+      return;
+    }
+
+    dt = recordedDt;
+
+    for (uint16_t i = 0; i < count; ++i)
+    {
+      InputCommand command;
+      command.frame = CharacterManager::GetFrame();
+
+      if (!Read(command.character) || !Read(command.verb) || !Read(command.direction))
+      {
+        Logger::Msg("Replay is cut short", Error);
+        StopPlayback();
+        return;
+      }
+
+      commands.push_back(command);
+    }
+  }
+
+  if (recording)
+  {
+    Write(dt);
+    Write(static_cast<uint16_t>(commands.size()));
+
+    for (const InputCommand& command : commands)
+    {
+      Write(command.character);
+      Write(command.verb);
+      Write(command.direction);
+    }
+  }
+}
+
+void CharacterReplay::EndFrame(uint64_t hash)
+{
+  if (playing)
+  {
+    uint64_t recordedHash = 0;
+
+    if (!Read(recordedHash))
+    {
+      Logger::Msg("Replay is cut short", Error);
+      StopPlayback();
+      return;
+    }
+
+    if (recordedHash != hash && mismatchFrame < 0)
+    {
+      mismatchFrame = playbackFrame;
+      Logger::Msg("Replay diverged at frame " + std::to_string(playbackFrame), Error);
+    }
+
+    ++playbackFrame;
+  }
+
+  if (recording)
+  {
+    Write(hash);
+  }
+}
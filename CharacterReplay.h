@@ -0,0 +1,90 @@
+// Copyright  2017 DigiPen (USA) Corporation.
+/*!
+*******************************************************************************
+\file    CharacterReplay.h
+\author  James Liao
+\par     email: james.liao\@digipen.edu
+\par     Course: GAM200F17-A
+\brief   Records the input, timestep and random state CharacterManager uses
+         each frame to a binary file, and plays it back. Every frame also
+         stores a hash of the character state, so playback can report the
+         first frame that comes out differently.
+*******************************************************************************/
+
+#pragma once
+#include "InputCommand.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define REPLAY_MAGIC 0x50524246u //!< "FBRP" read as little endian
+#define REPLAY_VERSION 2         //!< Bump when the file layout changes
+
+namespace fb
+{
+  class CharacterReplay
+  {
+    public:
+      /*!
+      *******************************************************************************
+      \brief   Starts writing every simulated frame to a file. Should be called
+               right after the characters are set up, so playback can start
+               from the same place.
+      \param   path
+        Where to write the replay (const std::string &).
+      \return  True if the file could be opened (bool).
+      *******************************************************************************/
+      static bool StartRecording(const std::string& path);
+
+      /*!
+      *******************************************************************************
+      \brief   Finishes the file being recorded
+      \return  None (void).
+      *******************************************************************************/
+      static void StopRecording();
+
+      /*!
+      *******************************************************************************
+      \brief   Loads a replay and starts feeding it to CharacterManager. Live
+               input is ignored until it runs out. The characters should be
+               set up the same way as when it was recorded.
+      \param   path
+        The replay to play (const std::string &).
+      \return  True if the file could be read (bool).
+      *******************************************************************************/
+      static bool StartPlayback(const std::string& path);
+
+      /*!
+      *******************************************************************************
+      \brief   Stops playing back, going back to live input
+      \return  None (void).
+      *******************************************************************************/
+      static void StopPlayback();
+
+      static bool IsRecording();            //!< Whether or not frames are being written
+      static bool IsPlaying();              //!< Whether or not frames are being read back
+      static int GetMismatchFrame();        //!< First played back frame whose hash was wrong, or -1
+
+      /*!
+      *******************************************************************************
+      \brief   Start of a simulated frame. Records the frame's input and timestep,
+               or swaps in the recorded ones during playback.
+      \param   dt
+        The frame's timestep, replaced during playback (float &).
+      \param   commands
+        The frame's input, replaced during playback (std::vector<InputCommand> &).
+      \return  None (void).
+      *******************************************************************************/
+      static void BeginFrame(float& dt, std::vector<InputCommand>& commands);
+
+      /*!
+      *******************************************************************************
+      \brief   End of a simulated frame. Records the state hash, or checks it
+               during playback.
+      \param   hash
+        Checksum of the character state at the end of the frame (uint64_t).
+      \return  None (void).
+      *******************************************************************************/
+      static void EndFrame(uint64_t hash);
+  };
+}
@@ -0,0 +1,63 @@
+// Copyright  2017 DigiPen (USA) Corporation.
+/*!
+*******************************************************************************
+\file    CharacterSink.h
+\author  James Liao
+\par     email: james.liao\@digipen.edu
+\par     Course: GAM200F17-A
+\brief   Interface every rendering, audio, haptics and popup side effect of
+         the character simulation goes through, so the simulation can run
+         without a window or devices.
+*******************************************************************************/
+
+#pragma once
+#include "Entity.h"
+#include "EventManager.h"
+#include "glm/vec2.hpp"
+
+namespace fb
+{
+  //! Particle effects the characters spawn
+  enum CharacterParticle
+  {
+    JumpParticle,       //!< Dust when jumping off the ground or a slime
+    DoubleJumpParticle, //!< Burst under the feet on a double jump
+    LandingParticle,    //!< Dust when touching down
+    PunchParticle,      //!< Swoosh in front of a punch
+    SquishParticle      //!< Slime dripping off a full bag
+  };
+
+  class CharacterSink
+  {
+    public:
+      virtual ~CharacterSink() {} //!< Virtual destructor
+
+      virtual void Notify(int character, const evt::CharacterEvent& event, int count) = 0; //!< Character event for audio and fist animation, character is -1 if it is about no one, count is how many copies from one tick were merged into it
+      virtual void Particle(CharacterParticle type, float size, glm::vec2 position, bool flipped = false) = 0; //!< Spawns a particle effect
+      virtual void Squash(const std::shared_ptr<Entity>& entity, float rotation, float duration, float scale) = 0; //!< Squash and stretch on an entity
+      virtual void Face(int character, bool left) = 0; //!< Turns a character's sprite to face left or right
+      virtual void DeliveryPopup(int character, int weight, glm::vec2 position) = 0; //!< Shows how much is left in the bag after a delivery
+      virtual void EmptyPopup(int character, glm::vec2 position, bool screenspace) = 0; //!< Shows that the bag is empty
+      virtual void Vibrate(int controller, float low, float high, float duration) = 0; //!< Rumbles a controller
+      virtual void StopVibration(int controller) = 0; //!< Stops a controller rumbling
+      virtual void CameraShake(float strength, float duration) = 0; //!< Shakes the camera
+      virtual void CameraPing(glm::vec2 position, int weight) = 0; //!< Tells the camera a point of interest
+      virtual void Flush() {} //!< Called once at the end of every CharacterManager::Update, after the frame's effects
+  };
+
+  //! Sink that drops every side effect, for headless runs
+  class NullCharacterSink : public CharacterSink
+  {
+    public:
+      void Notify(int, const evt::CharacterEvent&, int) {}
+      void Particle(CharacterParticle, float, glm::vec2, bool) {}
+      void Squash(const std::shared_ptr<Entity>&, float, float, float) {}
+      void Face(int, bool) {}
+      void DeliveryPopup(int, int, glm::vec2) {}
+      void EmptyPopup(int, glm::vec2, bool) {}
+      void Vibrate(int, float, float, float) {}
+      void StopVibration(int) {}
+      void CameraShake(float, float) {}
+      void CameraPing(glm::vec2, int) {}
+  };
+}
@@ -0,0 +1,33 @@
+// Copyright  2017 DigiPen (USA) Corporation.
+/*!
+*******************************************************************************
+\file    CharacterSnapshot.h
+\author  James Liao
+\par     email: james.liao\@digipen.edu
+\par     Course: GAM200F17-A
+\brief   Copy of the whole character simulation at the end of a frame. Plain
+         fixed-size data, so saving and restoring one is a few copies with no
+         allocation.
+*******************************************************************************/
+
+#pragma once
+#include "CharacterState.h"
+#include "glm/vec2.hpp"
+#include <cstdint>
+
+#define SNAPSHOT_HISTORY 16 //!< How many past frames CharacterManager keeps snapshots of
+
+struct CharacterSnapshot
+{
+  uint32_t frame;       //!< Frame the snapshot was taken at the end of
+  uint32_t randomState; //!< State of CharacterManager's random number generator
+  int count;            //!< How many characters were in play
+
+  uint8_t flags[MAX_CHARACTERS];           //!< Packed CharacterFlag bits
+  float punchTimer[MAX_CHARACTERS];        //!< Cooldown between punches
+  float zoneTimer[MAX_CHARACTERS];         //!< Time left until the next delivery
+  SlimeBag slimeBag[MAX_CHARACTERS];       //!< The bag of slimes
+  glm::vec2 position[MAX_CHARACTERS];      //!< Transform position
+  glm::vec2 velocity[MAX_CHARACTERS];      //!< Body velocity
+  glm::vec2 acceleration[MAX_CHARACTERS];  //!< Body acceleration, which is how gravity is switched on and off
+};
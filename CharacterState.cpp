@@ -0,0 +1,31 @@
+// Author:   James Liao
+// Copyright  2017 DigiPen (USA) Corporation.
+#include "CharacterState.h"
+
+void CharacterStateTable::Reset(int id)
+{
+  flags[id] = OnFloorFlag;
+  punchTimer[id] = 0.0f;
+  zoneTimer[id] = 1.0f;
+  slimeBag[id].Reset(SLIME_BAG_CAPACITY);
+
+  if (id >= count)
+  {
+    count = id + 1;
+  }
+}
+
+void CharacterStateTable::Clear()
+{
+  count = 0;
+}
+
+void CharacterStateTable::TickPunchTimers(float dt)
+{
+  // Branch-free so the loop stays a straight run over one array
+  for (int i = 0; i < count; ++i)
+  {
+    float timer = punchTimer[i];
+    punchTimer[i] = timer > 0 ? timer - dt : timer;
+  }
+}
@@ -0,0 +1,71 @@
+// Copyright  2017 DigiPen (USA) Corporation.
+/*!
+*******************************************************************************
+\file    CharacterState.h
+\author  James Liao
+\par     email: james.liao\@digipen.edu
+\par     Course: GAM200F17-A
+\brief   Structure-of-arrays table holding the simulation state of every
+         character. Character objects are thin handles into this table.
+*******************************************************************************/
+
+#pragma once
+#include "SlimeBag.h"
+#include <cstdint>
+
+#define MAX_CHARACTERS 256 //!< How many characters the state table can hold
+#define CACHE_LINE_SIZE 64 //!< Alignment of each hot array in the state table
+#define SLIME_BAG_CAPACITY 5 //!< How many slimes a character can hold by default
+
+//! Movement flags, packed into one byte per character
+enum CharacterFlag : uint8_t
+{
+  CanJumpFlag = 1 << 0,          //!< The character can double jump
+  CanPunchFlag = 1 << 1,         //!< The character can punch
+  OnFloorFlag = 1 << 2,          //!< The character is standing on a platform
+  IsHitFlag = 1 << 3,            //!< The character has been hit (with a punch)
+  TerminalVelocityFlag = 1 << 4, //!< The character has reached the maximum jump speed
+  FirstJumpFlag = 1 << 5,        //!< The character has jumped once
+  PassThroughFlag = 1 << 6,      //!< The character can pass through passable platforms
+  FacingLeftFlag = 1 << 7        //!< The character is facing left
+};
+
+struct CharacterStateTable
+{
+  /*!
+  *******************************************************************************
+  \brief   Puts a character's slot back to its starting values, growing the
+           table if the slot is past the end
+  \param   id
+    The character ID to reset (int).
+  \return  None (void).
+  *******************************************************************************/
+  void Reset(int id);
+
+  /*!
+  *******************************************************************************
+  \brief   Empties the table
+  \return  None (void).
+  *******************************************************************************/
+  void Clear();
+
+  /*!
+  *******************************************************************************
+  \brief   Ticks every active punch cooldown down in a single pass
+  \param   dt
+    The change in time since last update (float).
+  \return  None (void).
+  *******************************************************************************/
+  void TickPunchTimers(float dt);
+
+  bool HasFlag(int id, uint8_t flag) const { return (flags[id] & flag) != 0; } //!< Reads one movement flag
+  void SetFlag(int id, uint8_t flag, bool set) { flags[id] = set ? (flags[id] | flag) : (flags[id] & ~flag); } //!< Writes one movement flag
+
+  int count; //!< How many slots are in use
+
+  // Hot data, touched every frame for every character
+  alignas(CACHE_LINE_SIZE) uint8_t flags[MAX_CHARACTERS];     //!< Packed CharacterFlag bits
+  alignas(CACHE_LINE_SIZE) float punchTimer[MAX_CHARACTERS];  //!< Cooldown between punches
+  alignas(CACHE_LINE_SIZE) float zoneTimer[MAX_CHARACTERS];   //!< How long the player needs to be in the zone
+  alignas(CACHE_LINE_SIZE) SlimeBag slimeBag[MAX_CHARACTERS];  //!< The bag of slimes
+};
@@ -0,0 +1,63 @@
+// Author:   James Liao
+// Copyright  2017 DigiPen (USA) Corporation.
+#include "ContactArena.h"
+
+using namespace fb;
+
+ContactArena::ContactArena(unsigned blockSize)
+{
+  blockSize_ = blockSize;
+  block_ = 0;
+  used_ = 0;
+}
+
+ContactSpan ContactArena::Store(const CollisionResult& result)
+{
+  ContactSpan span;
+  span.data = nullptr;
+  span.count = 0;
+
+  if (!result.collision || !result.numCollisions)
+  {
+    return span;
+  }
+
+  const BoxCollider** out = Reserve(result.numCollisions);
+
+  // Skip empty slots so callers never have to null check
+  for (unsigned i = 0; i < result.numCollisions; ++i)
+  {
+    if (result.boxCollisions[i])
+    {
+      out[span.count++] = result.boxCollisions[i];
+    }
+  }
+
+  used_ += span.count;
+  span.data = out;
+  return span;
+}
+
+void ContactArena::Reset()
+{
+  block_ = 0;
+  used_ = 0;
+}
+
+const BoxCollider** ContactArena::Reserve(unsigned count)
+{
+  // Move on to the next block that has room, blocks are never resized so old spans stay valid
+  while (block_ < blocks_.size() && used_ + count > blocks_[block_].size())
+  {
+    ++block_;
+    used_ = 0;
+  }
+
+  if (block_ == blocks_.size())
+  {
+    blocks_.emplace_back(count > blockSize_ ? count : blockSize_);
+    used_ = 0;
+  }
+
+  return blocks_[block_].data() + used_;
+}
@@ -0,0 +1,76 @@
+// Copyright  2017 DigiPen (USA) Corporation.
+/*!
+*******************************************************************************
+\file    ContactArena.h
+\author  James Liao
+\par     email: james.liao\@digipen.edu
+\par     Course: GAM200F17-A
+\brief   Per-frame storage for collider lists. Collision results are copied
+         in and handed back as spans, and the whole arena is rewound once a
+         frame, so contact lists have no fixed size and cost no allocations
+         once the arena has warmed up.
+*******************************************************************************/
+
+#pragma once
+#include "Collider.h"
+#include <vector>
+
+namespace fb
+{
+  //! A run of colliders stored in a ContactArena
+  struct ContactSpan
+  {
+    const BoxCollider* const* data; //!< First collider in the run
+    unsigned count;                 //!< How many colliders are in the run
+
+    const BoxCollider* const* begin() const { return data; }        //!< Start of the run
+    const BoxCollider* const* end() const { return data + count; }  //!< One past the end of the run
+    unsigned size() const { return count; }                         //!< How many colliders are in the run
+    bool empty() const { return count == 0; }                       //!< Whether or not the run is empty
+    const BoxCollider* operator[](unsigned i) const { return data[i]; } //!< Collider at an index
+  };
+
+  class ContactArena
+  {
+    public:
+      /*!
+      *******************************************************************************
+      \brief   Constructor
+      \param   blockSize
+        How many colliders each block of the arena holds (unsigned).
+      *******************************************************************************/
+      ContactArena(unsigned blockSize = 1024);
+
+      /*!
+      *******************************************************************************
+      \brief   Copies every collider of a collision result into the arena
+      \param   result
+        The collision result to copy (const CollisionResult &).
+      \return  Span over the copied colliders, valid until Reset (ContactSpan).
+      *******************************************************************************/
+      ContactSpan Store(const CollisionResult& result);
+
+      /*!
+      *******************************************************************************
+      \brief   Rewinds the arena. Every span handed out before is invalidated,
+               but the memory is kept for the next frame.
+      \return  None (void).
+      *******************************************************************************/
+      void Reset();
+
+    private:
+      /*!
+      *******************************************************************************
+      \brief   Finds room for a run of colliders, adding a block if none has room
+      \param   count
+        How many colliders need to fit (unsigned).
+      \return  Where the run should be written (const BoxCollider **).
+      *******************************************************************************/
+      const BoxCollider** Reserve(unsigned count);
+
+      std::vector<std::vector<const BoxCollider*>> blocks_; //!< Storage blocks, never resized once created
+      unsigned blockSize_;  //!< Capacity of a regular block
+      unsigned block_;      //!< Block currently being filled
+      unsigned used_;       //!< How much of the current block is filled
+  };
+}
@@ -0,0 +1,32 @@
+// Copyright  2017 DigiPen (USA) Corporation.
+/*!
+*******************************************************************************
+\file    Direction.h
+\author  James Liao
+\par     email: james.liao\@digipen.edu
+\par     Course: GAM200F17-A
+\brief   Direction held on a controller. The game uses the one real
+         definition in the controller code. Headless builds have no
+         controller code, so they get a stand-in instead. Its values only
+         have to agree with other headless builds, so replays and checksums
+         made headless should not be compared with ones from the game.
+*******************************************************************************/
+
+#pragma once
+
+#ifdef FB_HEADLESS
+
+enum Direction
+{
+  Center, //!< Nothing held
+  Left,
+  Right,
+  Up,
+  Down
+};
+
+#else
+
+#include "ControllerHandler.h"
+
+#endif
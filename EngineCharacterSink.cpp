@@ -0,0 +1,156 @@
+// Author:   James Liao
+// Copyright  2017 DigiPen (USA) Corporation.
+#include "EngineCharacterSink.h"
+
+#ifndef FB_HEADLESS
+
+#include "CharacterHandler.h"
+#include "CharacterEventRouter.h"
+#include "ControllerHandler.h"
+#include "HapticsScheduler.h"
+#include "MakeParticles.h"
+#include "PopupText.h"
+#include "SquashPool.h"
+#include "Sprite.h"
+#include "Time.h"
+#include <string>
+
+using namespace fb;
+
+EngineCharacterSink::EngineCharacterSink()
+{
+  emptyText_ = StringTable::Intern("EMPTY!");
+}
+
+void EngineCharacterSink::StartHaptics()
+{
+  // Rumble goes through the scheduler, which makes the controller calls on its own thread
+  HapticsScheduler::Init([](const HapticsCommand& command)
+  {
+    if (command.controller >= ControllerManager::GetNumPlayers())
+    {
+      return;
+    }
+
+    if (command.stop)
+      ControllerManager::GetController(command.controller)->StopVibration();
+    else
+      ControllerManager::GetController(command.controller)->VibrateController(command.low, command.high, command.duration);
+  });
+}
+
+void EngineCharacterSink::Notify(int character, const evt::CharacterEvent& event, int count)
+{
+  // Observers of every character (audio) listen on the global subject. A punch landing on
+  // three targets is three hit sounds, so they hear every merged copy.
+  for (int i = 0; i < count; ++i)
+  {
+    evt::EventManager::GetCharacterEventSubject().Notify(event);
+  }
+
+  // Observers of one character (fists) only hear about that character, and one animation covers every copy
+  CharacterEventRouter::Notify(character, event);
+}
+
+void EngineCharacterSink::Particle(CharacterParticle type, float size, glm::vec2 position, bool flipped)
+{
+  switch (type)
+  {
+    case JumpParticle:
+      MakeJumpParticle(size, position);
+      break;
+
+    case DoubleJumpParticle:
+      MakeDoubleJumpParticle(size, position, flipped);
+      break;
+
+    case LandingParticle:
+      MakeLandingParticle(size, position, flipped);
+      break;
+
+    case PunchParticle:
+      MakePunchParticle(size, position);
+      break;
+
+    case SquishParticle:
+      MakeSquishParticle(size, position);
+      break;
+  }
+}
+
+void EngineCharacterSink::Squash(const std::shared_ptr<Entity>& entity, float rotation, float duration, float scale)
+{
+  SquashPool::Trigger(entity, rotation, duration, scale);
+}
+
+void EngineCharacterSink::Face(int character, bool left)
+{
+  const std::shared_ptr<Sprite>& sprite = CharacterManager::GetCharacter(character)->getSprite();
+
+  if (sprite)
+    sprite->SetFlipped(left);
+}
+
+void EngineCharacterSink::DeliveryPopup(int character, int weight, glm::vec2 position)
+{
+  int slot = CharacterManager::GetSlot(character);
+  PopupNumber::Make(weight, PopupText::TeamColors[slot], position, 3.0f, 1.0f);
+
+  // Only the first character in each slot has a spot on the HUD
+  if (character < PLAYER_SLOTS)
+  {
+    ScreenspacePopupText::Make(StringTable::Get(StringTable::Number(weight)), PopupText::TeamColors[slot], { -0.8 + character * 1.6 / 3, -0.5 }, 0, 1.0f, true, character);
+  }
+}
+
+void EngineCharacterSink::EmptyPopup(int character, glm::vec2 position, bool screenspace)
+{
+  if (screenspace && character < PLAYER_SLOTS)
+  {
+    PopupText::Make(StringTable::Get(emptyText_), PopupText::UI_ColorRed, position, 3.0f, 1.0f, true);
+    ScreenspacePopupText::Make(StringTable::Get(emptyText_), PopupText::UI_ColorRed, { -0.8 + character * 1.6 / 3, -0.5 }, 0, 1.0f, true, character);
+  }
+  else
+  {
+    PopupText::Make(StringTable::Get(emptyText_), PopupText::UI_ColorRed, position, 3.0f, 1.0f);
+  }
+}
+
+void EngineCharacterSink::Vibrate(int controller, float low, float high, float duration)
+{
+  // AI driven characters have no controller
+  if (controller >= ControllerManager::GetNumPlayers())
+  {
+    return;
+  }
+
+  HapticsScheduler::Request(controller, low, high, duration);
+}
+
+void EngineCharacterSink::StopVibration(int controller)
+{
+  if (controller >= ControllerManager::GetNumPlayers())
+  {
+    return;
+  }
+
+  HapticsScheduler::Stop(controller);
+}
+
+void EngineCharacterSink::CameraShake(float strength, float duration)
+{
+  CamManager::CamShake::Set(strength, duration);
+}
+
+void EngineCharacterSink::CameraPing(glm::vec2 position, int weight)
+{
+  CamManager::DynamicPing(position, weight);
+}
+
+void EngineCharacterSink::Flush()
+{
+  // Every rumble for the frame has been requested by now
+  HapticsScheduler::Submit(Time::GetDT());
+}
+
+#endif
@@ -0,0 +1,53 @@
+// Copyright  2017 DigiPen (USA) Corporation.
+/*!
+*******************************************************************************
+\file    EngineCharacterSink.h
+\author  James Liao
+\par     email: james.liao\@digipen.edu
+\par     Course: GAM200F17-A
+\brief   Character sink that forwards side effects to the game's particle,
+         popup, controller, camera and event systems. Not built when
+         FB_HEADLESS is defined.
+*******************************************************************************/
+
+#pragma once
+#include "CharacterSink.h"
+#include "StringTable.h"
+
+#ifndef FB_HEADLESS
+
+namespace fb
+{
+  class EngineCharacterSink : public CharacterSink
+  {
+    public:
+      EngineCharacterSink();
+
+      /*!
+      *******************************************************************************
+      \brief   Starts the haptics device thread. Does nothing if it is already
+               running. HapticsScheduler::Shutdown has to be called to stop it
+               while the controllers still exist, CharacterManager::Shutdown
+               does this.
+      \return  None (void).
+      *******************************************************************************/
+      void StartHaptics();
+
+      void Notify(int character, const evt::CharacterEvent& event, int count);
+      void Particle(CharacterParticle type, float size, glm::vec2 position, bool flipped);
+      void Squash(const std::shared_ptr<Entity>& entity, float rotation, float duration, float scale);
+      void Face(int character, bool left);
+      void DeliveryPopup(int character, int weight, glm::vec2 position);
+      void EmptyPopup(int character, glm::vec2 position, bool screenspace);
+      void Vibrate(int controller, float low, float high, float duration);
+      void StopVibration(int controller);
+      void CameraShake(float strength, float duration);
+      void CameraPing(glm::vec2 position, int weight);
+      void Flush();
+
+    private:
+      StringId emptyText_; //!< Interned "EMPTY!" popup text
+  };
+}
+
+#endif
@@ -0,0 +1,204 @@
+// Author:   James Liao
+// Copyright  2017 DigiPen (USA) Corporation.
+#include "HapticsScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace fb;
+
+#define RUMBLE_EPSILON 0.01f // Motor strengths closer than this count as the same
+#define RUMBLE_REFRESH 0.5f  // A running rumble is only topped up once less than this share of a request is left
+
+namespace
+{
+  //! What was asked for this frame
+  struct Pending
+  {
+    bool requested;
+    bool stop;
+    float low;
+    float high;
+    float duration;
+  };
+
+  //! What the controller was last told to do
+  struct Active
+  {
+    float low;
+    float high;
+    float remaining;
+  };
+
+  Pending pending[HAPTICS_CONTROLLERS];
+  Active active[HAPTICS_CONTROLLERS];
+
+  HapticsScheduler::Device device;
+  std::thread ioThread;
+  std::mutex queueLock;
+  std::condition_variable queueReady;
+  std::vector<HapticsCommand> queue;   // Commands waiting for the device thread
+  std::vector<HapticsCommand> outgoing; // This frame's commands, kept to reuse the memory
+  bool running = false;
+
+  void IoMain()
+  {
+    std::vector<HapticsCommand> batch;
+
+    for (;;)
+    {
+      {
+        std::unique_lock<std::mutex> guard(queueLock);
+        queueReady.wait(guard, []() { return !running || !queue.empty(); });
+
+        if (!running)
+        {
+          return;
+        }
+
+        batch.swap(queue);
+      }
+
+      for (const HapticsCommand& command : batch)
+      {
+        device(command);
+      }
+
+      batch.clear();
+    }
+  }
+
+  bool Same(float a, float b)
+  {
+    return std::fabs(a - b) < RUMBLE_EPSILON;
+  }
+}
+
+void HapticsScheduler::Init(const Device& newDevice)
+{
+  if (running)
+  {
+    return;
+  }
+
+  device = newDevice;
+
+  for (int i = 0; i < HAPTICS_CONTROLLERS; ++i)
+  {
+    pending[i] = Pending();
+    active[i] = Active();
+  }
+
+  running = true;
+  ioThread = std::thread(IoMain);
+}
+
+void HapticsScheduler::Shutdown()
+{
+  if (!running)
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(queueLock);
+    running = false;
+    queue.clear();
+  }
+
+  queueReady.notify_one();
+  ioThread.join();
+}
+
+void HapticsScheduler::Request(int controller, float low, float high, float duration)
+{
+  if (controller < 0 || controller >= HAPTICS_CONTROLLERS)
+  {
+    return;
+  }
+
+  Pending& request = pending[controller];
+
+  if (!request.requested)
+  {
+    request.requested = true;
+    request.low = low;
+    request.high = high;
+    request.duration = duration;
+  }
+  else
+  {
+    request.low = std::max(request.low, low);
+    request.high = std::max(request.high, high);
+    request.duration = std::max(request.duration, duration);
+  }
+}
+
+void HapticsScheduler::Stop(int controller)
+{
+  if (controller < 0 || controller >= HAPTICS_CONTROLLERS)
+  {
+    return;
+  }
+
+  // Anything asked for before the stop is cancelled, anything after still goes through
+  pending[controller].requested = false;
+  pending[controller].stop = true;
+}
+
+void HapticsScheduler::Submit(float dt)
+{
+  if (!running)
+  {
+    return;
+  }
+
+  outgoing.clear();
+
+  for (int i = 0; i < HAPTICS_CONTROLLERS; ++i)
+  {
+    Pending& request = pending[i];
+    Active& state = active[i];
+
+    if (request.requested)
+    {
+      bool same = state.remaining > 0.0f && Same(state.low, request.low) && Same(state.high, request.high);
+
+      // Already rumbling like this with enough time left, the device doesn't need to hear it again
+      if (!same || state.remaining < request.duration * RUMBLE_REFRESH)
+      {
+        HapticsCommand command = { i, false, request.low, request.high, request.duration };
+        outgoing.push_back(command);
+
+        state.low = request.low;
+        state.high = request.high;
+        state.remaining = request.duration;
+      }
+    }
+    else if (request.stop && state.remaining > 0.0f)
+    {
+      HapticsCommand command = { i, true, 0.0f, 0.0f, 0.0f };
+      outgoing.push_back(command);
+
+      state.remaining = 0.0f;
+    }
+
+    state.remaining = std::max(0.0f, state.remaining - dt);
+    request = Pending();
+  }
+
+  if (outgoing.empty())
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(queueLock);
+    queue.insert(queue.end(), outgoing.begin(), outgoing.end());
+  }
+
+  queueReady.notify_one();
+}
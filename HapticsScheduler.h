@@ -0,0 +1,88 @@
+// Copyright  2017 DigiPen (USA) Corporation.
+/*!
+*******************************************************************************
+\file    HapticsScheduler.h
+\author  James Liao
+\par     email: james.liao\@digipen.edu
+\par     Course: GAM200F17-A
+\brief   Collects rumble requests for each controller over a frame, merges
+         them, and only talks to the device when what the controller should
+         be doing actually changes. Device calls run on their own thread.
+*******************************************************************************/
+
+#pragma once
+#include <functional>
+
+#define HAPTICS_CONTROLLERS 8 //!< How many controllers the scheduler tracks, requests for others are dropped
+
+namespace fb
+{
+  //! One call to make on a controller
+  struct HapticsCommand
+  {
+    int controller; //!< Which controller
+    bool stop;      //!< Stop rumbling instead of starting
+    float low;      //!< Low frequency motor strength
+    float high;     //!< High frequency motor strength
+    float duration; //!< How long to rumble for, in seconds
+  };
+
+  class HapticsScheduler
+  {
+    public:
+      //! Makes the actual device call, on the scheduler's thread
+      typedef std::function<void(const HapticsCommand&)> Device;
+
+      /*!
+      *******************************************************************************
+      \brief   Starts the device thread
+      \param   device
+        What to call for every command that gets through (const Device &).
+      \return  None (void).
+      *******************************************************************************/
+      static void Init(const Device& device);
+
+      /*!
+      *******************************************************************************
+      \brief   Stops and joins the device thread, dropping anything not sent yet
+      \return  None (void).
+      *******************************************************************************/
+      static void Shutdown();
+
+      /*!
+      *******************************************************************************
+      \brief   Asks for a rumble. Requests in the same frame are merged, using
+               the strongest motor values and the longest duration.
+      \param   controller
+        Which controller to rumble (int).
+      \param   low
+        Low frequency motor strength (float).
+      \param   high
+        High frequency motor strength (float).
+      \param   duration
+        How long to rumble for, in seconds (float).
+      \return  None (void).
+      *******************************************************************************/
+      static void Request(int controller, float low, float high, float duration);
+
+      /*!
+      *******************************************************************************
+      \brief   Asks for a controller to stop rumbling. Cancels the requests
+               made for it earlier in the frame.
+      \param   controller
+        Which controller to stop (int).
+      \return  None (void).
+      *******************************************************************************/
+      static void Stop(int controller);
+
+      /*!
+      *******************************************************************************
+      \brief   Ends the frame. Works out what each controller should be doing,
+               and queues a device call for those where that changed.
+      \param   dt
+        The change in time since last submit (float).
+      \return  None (void).
+      *******************************************************************************/
+      static void Submit(float dt);
+  };
+}
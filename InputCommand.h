@@ -0,0 +1,89 @@
+// Copyright  2017 DigiPen (USA) Corporation.
+/*!
+*******************************************************************************
+\file    InputCommand.h
+\author  James Liao
+\par     email: james.liao\@digipen.edu
+\par     Course: GAM200F17-A
+\brief   Plain input command format written into the per-frame command buffer
+         and consumed by CharacterManager.
+*******************************************************************************/
+
+#pragma once
+#include <cstdint>
+
+//! What an input command asks a character to do
+enum InputVerb : uint8_t
+{
+  VerbMove,          //!< Move in a direction
+  VerbJump,          //!< Jump, or drop through a platform when the direction is down
+  VerbBasicAttack,   //!< Punch in a direction
+  VerbSpecialAttack, //!< Special attack in a direction
+  VerbBlock,         //!< Block attacks
+  VerbCount
+};
+
+//! One input for one character, plain data so it can be copied or written straight to disk
+struct InputCommand
+{
+  uint32_t frame;     //!< Frame the input was submitted on
+  uint16_t character; //!< ID of the character the input is for
+  uint8_t verb;       //!< What to do (InputVerb)
+  uint8_t direction;  //!< Which way to do it (Direction)
+};
+
+//! Every input a character received in one frame, folded together so it is acted on once
+struct CharacterIntent
+{
+  bool active;             //!< Whether or not any input arrived this frame
+  bool move;               //!< Some input carried a direction to move in
+  bool jump;               //!< A jump was pressed
+  bool attack;             //!< A basic attack was pressed
+  bool special;            //!< A special attack was pressed
+  bool block;              //!< Block was pressed
+  uint8_t moveDirection;   //!< Horizontal input, the last direction seen this frame (Direction)
+  uint8_t jumpDirection;   //!< Direction of the jump, down means drop through a platform (Direction)
+  uint8_t attackDirection; //!< Direction of the basic attack (Direction)
+  uint8_t specialDirection; //!< Direction of the special attack (Direction)
+
+  /*!
+  *******************************************************************************
+  \brief   Folds a command into the intent
+  \param   command
+    The command to add (const InputCommand &).
+  \return  None (void).
+  *******************************************************************************/
+  void Add(const InputCommand& command)
+  {
+    active = true;
+
+    // Moving, jumping and punching also steer the character, special attacks and block don't
+    if (command.verb == VerbMove || command.verb == VerbJump || command.verb == VerbBasicAttack)
+    {
+      move = true;
+      moveDirection = command.direction;
+    }
+
+    switch (command.verb)
+    {
+      case VerbJump:
+        jump = true;
+        jumpDirection = command.direction;
+        break;
+
+      case VerbBasicAttack:
+        attack = true;
+        attackDirection = command.direction;
+        break;
+
+      case VerbSpecialAttack:
+        special = true;
+        specialDirection = command.direction;
+        break;
+
+      case VerbBlock:
+        block = true;
+        break;
+    }
+  }
+};
@@ -0,0 +1,232 @@
+// Author:   James Liao
+// Copyright  2017 DigiPen (USA) Corporation.
+#include "JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace fb;
+
+namespace
+{
+  //! A slice of the range handed to ParallelFor
+  struct Chunk
+  {
+    int begin;
+    int end;
+  };
+
+  //! Chunks waiting on one worker. The owner takes from the front, thieves from the back.
+  struct WorkQueue
+  {
+    std::mutex lock;
+    std::deque<Chunk> chunks;
+  };
+
+  std::vector<std::thread> threads;           // Workers 1 and up, worker 0 is whoever calls ParallelFor
+  std::unique_ptr<WorkQueue[]> queues;        // One queue per worker
+  int workerCount = 1;
+  bool running = false;
+
+  std::mutex wakeLock;                        // Guards generation and stopping
+  std::condition_variable wake;               // Signalled when there is new work or on shutdown
+  unsigned generation = 0;                    // Bumped once per ParallelFor
+  bool stopping = false;
+
+  const JobSystem::RangeJob* currentJob = nullptr;
+  std::atomic<int> remaining(0);              // Chunks of the current job not finished yet
+  std::mutex doneLock;                        // Taken when the last chunk finishes, so the wakeup can't be missed
+  std::condition_variable done;               // Signalled when remaining reaches zero
+
+  bool PopOwn(int worker, Chunk& chunk)
+  {
+    WorkQueue& queue = queues[worker];
+    std::lock_guard<std::mutex> guard(queue.lock);
+
+    if (queue.chunks.empty())
+    {
+      return false;
+    }
+
+    chunk = queue.chunks.front();
+    queue.chunks.pop_front();
+    return true;
+  }
+
+  bool Steal(int thief, Chunk& chunk)
+  {
+    for (int offset = 1; offset < workerCount; ++offset)
+    {
+      WorkQueue& queue = queues[(thief + offset) % workerCount];
+      std::lock_guard<std::mutex> guard(queue.lock);
+
+      if (!queue.chunks.empty())
+      {
+        chunk = queue.chunks.back();
+        queue.chunks.pop_back();
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  // Runs chunks until there are none left anywhere
+  void Drain(int worker)
+  {
+    Chunk chunk;
+
+    while (PopOwn(worker, chunk) || Steal(worker, chunk))
+    {
+      (*currentJob)(chunk.begin, chunk.end, worker);
+
+      if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      {
+        std::lock_guard<std::mutex> guard(doneLock);
+        done.notify_one();
+      }
+    }
+  }
+
+  void WorkerMain(int worker)
+  {
+    unsigned seen = 0;
+
+    for (;;)
+    {
+      {
+        std::unique_lock<std::mutex> guard(wakeLock);
+        wake.wait(guard, [&seen]() { return stopping || generation != seen; });
+
+        if (stopping)
+        {
+          return;
+        }
+
+        seen = generation;
+      }
+
+      Drain(worker);
+    }
+  }
+
+  // Joins the workers if the game exits without calling Shutdown
+  struct JobSystemGuard
+  {
+    ~JobSystemGuard() { JobSystem::Shutdown(); }
+  } jobSystemGuard;
+}
+
+void JobSystem::Init(int workers)
+{
+  if (running)
+  {
+    return;
+  }
+
+  if (workers <= 0)
+  {
+    workers = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  workerCount = workers;
+  queues.reset(new WorkQueue[workerCount]);
+
+  for (int i = 1; i < workerCount; ++i)
+  {
+    threads.emplace_back(WorkerMain, i);
+  }
+
+  running = true;
+}
+
+void JobSystem::Shutdown()
+{
+  if (!running)
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(wakeLock);
+    stopping = true;
+  }
+
+  wake.notify_all();
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  threads.clear();
+  queues.reset();
+  workerCount = 1;
+  stopping = false;
+  running = false;
+}
+
+bool JobSystem::Running()
+{
+  return running;
+}
+
+int JobSystem::GetWorkerCount()
+{
+  return workerCount;
+}
+
+void JobSystem::ParallelFor(int count, int grain, const RangeJob& job)
+{
+  if (count <= 0)
+  {
+    return;
+  }
+
+  grain = std::max(1, grain);
+
+  // Not worth waking anyone up for a single chunk
+  if (!running || workerCount == 1 || count <= grain)
+  {
+    job(0, count, 0);
+    return;
+  }
+
+  // Publish the job before any chunk can be taken, workers may still be looking for leftovers
+  currentJob = &job;
+  remaining.store((count + grain - 1) / grain, std::memory_order_release);
+
+  // Deal the chunks out round robin, stealing evens out whatever this gets wrong
+  int target = 0;
+
+  for (int begin = 0; begin < count; begin += grain)
+  {
+    WorkQueue& queue = queues[target];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    queue.chunks.push_back({ begin, std::min(begin + grain, count) });
+
+    target = (target + 1) % workerCount;
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(wakeLock);
+    ++generation;
+  }
+
+  wake.notify_all();
+
+  // Help out, then sleep until the chunks other workers are still running are done
+  Drain(0);
+
+  {
+    std::unique_lock<std::mutex> guard(doneLock);
+    done.wait(guard, []() { return remaining.load(std::memory_order_acquire) == 0; });
+  }
+
+  currentJob = nullptr;
+}
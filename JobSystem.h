@@ -0,0 +1,72 @@
+// Copyright  2017 DigiPen (USA) Corporation.
+/*!
+*******************************************************************************
+\file    JobSystem.h
+\author  James Liao
+\par     email: james.liao\@digipen.edu
+\par     Course: GAM200F17-A
+\brief   Small pool of worker threads that split a range of work between
+         them. Every worker owns a queue of chunks, and steals from the
+         others once its own queue runs dry.
+*******************************************************************************/
+
+#pragma once
+#include <functional>
+
+namespace fb
+{
+  class JobSystem
+  {
+    public:
+      //! Work on [begin, end), run by the worker with the given index
+      typedef std::function<void(int begin, int end, int worker)> RangeJob;
+
+      /*!
+      *******************************************************************************
+      \brief   Starts the worker threads. Does nothing if they are already running.
+      \param   workers
+        How many workers to use, counting the calling thread. 0 uses one per
+        hardware thread (int).
+      \return  None (void).
+      *******************************************************************************/
+      static void Init(int workers = 0);
+
+      /*!
+      *******************************************************************************
+      \brief   Stops and joins the worker threads
+      \return  None (void).
+      *******************************************************************************/
+      static void Shutdown();
+
+      /*!
+      *******************************************************************************
+      \brief   Returns whether or not the worker threads are running
+      \return  True if Init has been called without a matching Shutdown (bool).
+      *******************************************************************************/
+      static bool Running();
+
+      /*!
+      *******************************************************************************
+      \brief   How many workers ParallelFor can hand work to, counting the calling
+               thread. Per-worker buffers should be sized with this.
+      \return  The number of workers, at least 1 (int).
+      *******************************************************************************/
+      static int GetWorkerCount();
+
+      /*!
+      *******************************************************************************
+      \brief   Splits [0, count) into chunks and runs them on every worker,
+               returning once all of them are done. The calling thread works
+               as worker 0. Not reentrant, and only one thread may call it at
+               a time. Runs inline if the workers are not running.
+      \param   count
+        How many items there are (int).
+      \param   grain
+        How many items go in each chunk (int).
+      \param   job
+        The work to run on each chunk (const RangeJob &).
+      \return  None (void).
+      *******************************************************************************/
+      static void ParallelFor(int count, int grain, const RangeJob& job);
+  };
+}
@@ -0,0 +1,81 @@
+// Copyright  2017 DigiPen (USA) Corporation.
+/*!
+*******************************************************************************
+\file    Kinematics.h
+\author  James Liao
+\par     email: james.liao\@digipen.edu
+\par     Course: GAM200F17-A
+\brief   Number types used for character velocity math. Normally plain floats.
+         When FB_FIXED_POINT_KINEMATICS is defined they are 16.16 fixed point
+         instead, so every build and every machine moves characters by
+         exactly the same amount. Bodies still store floats, so velocities
+         are converted on the way in and out.
+*******************************************************************************/
+
+#pragma once
+#include "glm/vec2.hpp"
+#include <cmath>
+#include <cstdint>
+
+#ifdef FB_FIXED_POINT_KINEMATICS
+
+#define FIXED_FRACTION_BITS 16 //!< Bits after the binary point
+#define FIXED_ONE (1 << FIXED_FRACTION_BITS) //!< Raw value of 1
+
+//! Signed 16.16 fixed point number, only integer operations touch the raw value
+struct Fixed
+{
+  int32_t raw; //!< The value times FIXED_ONE
+
+  //! Rounds to the nearest step. Scaling by a power of two is exact, so this is the same everywhere.
+  static Fixed FromFloat(float value) { return { static_cast<int32_t>(std::floor(value * FIXED_ONE + 0.5f)) }; }
+  float ToFloat() const { return static_cast<float>(raw) * (1.0f / FIXED_ONE); }
+
+  Fixed operator-() const { return { -raw }; }
+  Fixed operator+(Fixed rhs) const { return { raw + rhs.raw }; }
+  Fixed operator-(Fixed rhs) const { return { raw - rhs.raw }; }
+  Fixed operator*(Fixed rhs) const { return { static_cast<int32_t>((static_cast<int64_t>(raw) * rhs.raw) >> FIXED_FRACTION_BITS) }; }
+  Fixed operator/(Fixed rhs) const { return { static_cast<int32_t>((static_cast<int64_t>(raw) << FIXED_FRACTION_BITS) / rhs.raw) }; }
+  Fixed operator/(int rhs) const { return { raw / rhs }; }
+  Fixed& operator+=(Fixed rhs) { raw += rhs.raw; return *this; }
+  Fixed& operator-=(Fixed rhs) { raw -= rhs.raw; return *this; }
+
+  bool operator<(Fixed rhs) const { return raw < rhs.raw; }
+  bool operator>(Fixed rhs) const { return raw > rhs.raw; }
+  bool operator<=(Fixed rhs) const { return raw <= rhs.raw; }
+  bool operator>=(Fixed rhs) const { return raw >= rhs.raw; }
+};
+
+//! Two fixed point numbers, only what the character velocity math needs
+struct FixedVec2
+{
+  FixedVec2() : x({ 0 }), y({ 0 }) {}
+  FixedVec2(Fixed x, Fixed y) : x(x), y(y) {}
+
+  Fixed x;
+  Fixed y;
+};
+
+typedef Fixed KinematicScalar;  //!< One component of a velocity
+typedef FixedVec2 KinematicVec2; //!< A velocity
+
+inline KinematicScalar ToKinematic(float value) { return Fixed::FromFloat(value); }
+inline KinematicVec2 ToKinematic(glm::vec2 value) { return KinematicVec2(Fixed::FromFloat(value.x), Fixed::FromFloat(value.y)); }
+inline float ToFloat(KinematicScalar value) { return value.ToFloat(); }
+inline glm::vec2 ToFloat(KinematicVec2 value) { return glm::vec2(value.x.ToFloat(), value.y.ToFloat()); }
+inline KinematicScalar KinematicMin(KinematicScalar a, KinematicScalar b) { return b < a ? b : a; }
+inline KinematicScalar KinematicMax(KinematicScalar a, KinematicScalar b) { return a < b ? b : a; }
+
+#else
+
+typedef float KinematicScalar;     //!< One component of a velocity
+typedef glm::vec2 KinematicVec2;   //!< A velocity
+
+inline KinematicScalar ToKinematic(float value) { return value; }
+inline KinematicVec2 ToKinematic(glm::vec2 value) { return value; }
+inline float ToFloat(KinematicScalar value) { return value; }
+inline glm::vec2 ToFloat(KinematicVec2 value) { return value; }
+inline KinematicScalar KinematicMin(KinematicScalar a, KinematicScalar b) { return fminf(a, b); }
+inline KinematicScalar KinematicMax(KinematicScalar a, KinematicScalar b) { return fmaxf(a, b); }
+
+#endif
@@ -0,0 +1,129 @@
+// Copyright  2017 DigiPen (USA) Corporation.
+/*!
+*******************************************************************************
+\file    SlimeBag.h
+\author  James Liao
+\par     email: james.liao\@digipen.edu
+\par     Course: GAM200F17-A
+\brief   Fixed capacity bag of slimes carried by a character. Only the number
+         of normal and golden slimes is stored, so every operation is O(1)
+         and nothing is allocated.
+*******************************************************************************/
+
+#pragma once
+#include <cstdint>
+
+#define SLIME_NORMAL_WEIGHT 1 //!< Score value of a normal slime
+#define SLIME_GOLDEN_WEIGHT 5 //!< Score value of a golden slime
+
+struct SlimeBag
+{
+  uint8_t normal;   //!< How many normal slimes are in the bag
+  uint8_t golden;   //!< How many golden slimes are in the bag
+  uint8_t capacity; //!< How many slimes the bag can hold
+
+  //! Empties the bag and sets how many slimes it can hold
+  void Reset(int slots)
+  {
+    normal = 0;
+    golden = 0;
+    capacity = static_cast<uint8_t>(slots);
+  }
+
+  //! Empties the bag, keeping its capacity
+  void Clear()
+  {
+    normal = 0;
+    golden = 0;
+  }
+
+  int Size() const { return normal + golden; }                                       //!< How many slimes are in the bag
+  int Weight() const { return normal * SLIME_NORMAL_WEIGHT + golden * SLIME_GOLDEN_WEIGHT; } //!< Score value of the bag
+  bool IsFull() const { return Size() >= capacity; }                                  //!< Whether or not the bag has room left
+  bool IsEmpty() const { return Size() == 0; }                                        //!< Whether or not the bag is empty
+
+  /*!
+  *******************************************************************************
+  \brief   Puts a slime in the bag if there is room
+  \param   weight
+    The weight of the slime to add (int).
+  \return  True if the slime was added, false if the bag is full (bool).
+  *******************************************************************************/
+  bool Add(int weight)
+  {
+    if (IsFull())
+    {
+      return false;
+    }
+
+    if (weight == SLIME_GOLDEN_WEIGHT)
+      ++golden;
+    else
+      ++normal;
+
+    return true;
+  }
+
+  /*!
+  *******************************************************************************
+  \brief   Trades a normal slime in the bag for a golden one
+  \return  True if a normal slime was replaced, false otherwise (bool).
+  *******************************************************************************/
+  bool SwapInGolden()
+  {
+    if (!normal)
+    {
+      return false;
+    }
+
+    --normal;
+    ++golden;
+    return true;
+  }
+
+  /*!
+  *******************************************************************************
+  \brief   Takes the lightest slime out of the bag (normal before golden)
+  \return  The weight of the slime removed, or 0 if the bag is empty (int).
+  *******************************************************************************/
+  int Pop()
+  {
+    if (normal)
+    {
+      --normal;
+      return SLIME_NORMAL_WEIGHT;
+    }
+
+    if (golden)
+    {
+      --golden;
+      return SLIME_GOLDEN_WEIGHT;
+    }
+
+    return 0;
+  }
+
+  /*!
+  *******************************************************************************
+  \brief   Takes one slime of the given weight out of the bag
+  \param   weight
+    The weight of the slime to remove (int).
+  \return  True if a slime was removed, false otherwise (bool).
+  *******************************************************************************/
+  bool Remove(int weight)
+  {
+    if (weight == SLIME_GOLDEN_WEIGHT && golden)
+    {
+      --golden;
+      return true;
+    }
+
+    if (weight == SLIME_NORMAL_WEIGHT && normal)
+    {
+      --normal;
+      return true;
+    }
+
+    return false;
+  }
+};
@@ -0,0 +1,96 @@
+// Author:   James Liao
+// Copyright  2017 DigiPen (USA) Corporation.
+#include "SquashPool.h"
+
+#ifndef FB_HEADLESS
+
+using namespace fb;
+
+std::vector<std::shared_ptr<PunchFX>> SquashPool::pool;
+std::unordered_map<const Entity*, std::shared_ptr<PunchFX>> SquashPool::owned;
+size_t SquashPool::next;
+
+void SquashPool::Init(int size)
+{
+  pool.reserve(size);
+
+  while (pool.size() < static_cast<size_t>(size))
+  {
+    pool.push_back(std::make_shared<PunchFX>(0.0f, 0.0f, 0.0f));
+  }
+
+  next = 0;
+}
+
+void SquashPool::Reserve(const Entity* entity)
+{
+  std::shared_ptr<PunchFX>& tween = owned[entity];
+
+  if (!tween)
+  {
+    tween = std::make_shared<PunchFX>(0.0f, 0.0f, 0.0f);
+  }
+}
+
+void SquashPool::Trigger(const std::shared_ptr<Entity>& entity, float rotation, float duration, float scale)
+{
+  std::shared_ptr<PunchFX>* tween = nullptr;
+  auto reserved = owned.find(entity.get());
+
+  if (reserved != owned.end())
+  {
+    tween = &reserved->second;
+
+    // A hit can land while a jump squash is still playing, restart it instead of adding a second tween
+    if (!IsFree(*tween))
+    {
+      Restart(**tween, rotation, duration, scale);
+      return;
+    }
+  }
+  else
+  {
+    tween = &Free();
+  }
+
+  // The tween is detached here, so resetting it by assignment can't disturb an entity
+  **tween = PunchFX(rotation, duration, scale);
+  entity->AttachComponent(*tween);
+}
+
+void SquashPool::Restart(PunchFX& tween, float rotation, float duration, float scale)
+{
+  // Assigning a fresh tween would also overwrite the Component part, which is what ties it to its entity.
+  // Carry that part over, so only PunchFX's own squash values and timer start again.
+  PunchFX restarted(rotation, duration, scale);
+  static_cast<Component&>(restarted) = static_cast<const Component&>(tween);
+  tween = restarted;
+}
+
+std::shared_ptr<PunchFX>& SquashPool::Free()
+{
+  // Round robin, so the tween that finished longest ago is looked at first
+  for (size_t i = 0; i < pool.size(); ++i)
+  {
+    size_t index = (next + i) % pool.size();
+
+    if (IsFree(pool[index]))
+    {
+      next = index + 1;
+      return pool[index];
+    }
+  }
+
+  // Every tween is playing, grow the pool
+  pool.push_back(std::make_shared<PunchFX>(0.0f, 0.0f, 0.0f));
+  return pool.back();
+}
+
+void SquashPool::Clear()
+{
+  owned.clear();
+  pool.clear();
+  next = 0;
+}
+
+#endif
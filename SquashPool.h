@@ -0,0 +1,121 @@
+// Copyright  2017 DigiPen (USA) Corporation.
+/*!
+*******************************************************************************
+\file    SquashPool.h
+\author  James Liao
+\par     email: james.liao\@digipen.edu
+\par     Course: GAM200F17-A
+\brief   Reusable squash and stretch tweens. Characters each own one, and
+         every other entity borrows from a shared pool, so triggering a
+         squash never allocates a new component. Not built when FB_HEADLESS
+         is defined.
+*******************************************************************************/
+
+#pragma once
+
+#ifndef FB_HEADLESS
+
+#include "Entity.h"
+#include "PunchFX.h"
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace fb
+{
+  class SquashPool
+  {
+    public:
+      /*!
+      *******************************************************************************
+      \brief   Fills the shared pool
+      \param   size
+        How many tweens to make up front (int).
+      \return  None (void).
+      *******************************************************************************/
+      static void Init(int size);
+
+      /*!
+      *******************************************************************************
+      \brief   Gives an entity a tween of its own, used by every squash on it
+      \param   entity
+        The entity to reserve a tween for (const Entity *).
+      \return  None (void).
+      *******************************************************************************/
+      static void Reserve(const Entity* entity);
+
+      /*!
+      *******************************************************************************
+      \brief   Plays a squash on an entity. Uses the entity's own tween if it has
+               one, otherwise a free one from the pool. If the entity's own
+               tween is still playing, it is restarted with the new values
+               where it is, so the entity never has two tweens fighting over
+               its scale and the new squash is never dropped.
+      \param   entity
+        The entity to squash (const std::shared_ptr<Entity> &).
+      \param   rotation
+        How far to rotate during the squash (float).
+      \param   duration
+        How long the squash lasts (float).
+      \param   scale
+        How far to squash (float).
+      \return  None (void).
+      *******************************************************************************/
+      static void Trigger(const std::shared_ptr<Entity>& entity, float rotation, float duration, float scale);
+
+      /*!
+      *******************************************************************************
+      \brief   Forgets every reserved tween and empties the pool
+      \return  None (void).
+      *******************************************************************************/
+      static void Clear();
+
+    private:
+      /*!
+      *******************************************************************************
+      \brief   Whether or not a tween is free to play again. A tween nobody else
+               holds has finished and been removed from its entity. This relies
+               on the engine dropping a PunchFX from its entity once it has
+               played, which the game counted on before the pool existed: it
+               attached a new PunchFX for every squash and never removed one.
+      \param   tween
+        The tween to check (const std::shared_ptr<PunchFX> &).
+      \return  True if the tween can be attached again (bool).
+      *******************************************************************************/
+      static bool IsFree(const std::shared_ptr<PunchFX>& tween) { return tween.use_count() == 1; }
+
+      /*!
+      *******************************************************************************
+      \brief   Finds a tween in the pool that is free to play, growing the pool if
+               every tween is playing
+      \return  The free tween, its slot in the pool (std::shared_ptr<PunchFX> &).
+      *******************************************************************************/
+      static std::shared_ptr<PunchFX>& Free();
+
+      /*!
+      *******************************************************************************
+      \brief   Starts a tween that is attached and playing over again with new
+               values, without detaching it. Keeps the Component part of the
+               tween and resets the rest, so this relies on PunchFX keeping
+               everything it knows about its entity in Component. If PunchFX
+               ever caches something from its entity when attached, this has to
+               detach and attach it again instead.
+      \param   tween
+        The playing tween (PunchFX &).
+      \param   rotation
+        How far to rotate during the squash (float).
+      \param   duration
+        How long the squash lasts (float).
+      \param   scale
+        How far to squash (float).
+      \return  None (void).
+      *******************************************************************************/
+      static void Restart(PunchFX& tween, float rotation, float duration, float scale);
+
+      static std::vector<std::shared_ptr<PunchFX>> pool; //!< Tweens shared by entities without their own
+      static std::unordered_map<const Entity*, std::shared_ptr<PunchFX>> owned; //!< Tweens reserved for one entity
+      static size_t next; //!< Where to start looking for a free tween in the pool
+  };
+}
+
+#endif
@@ -0,0 +1,51 @@
+// Author:   James Liao
+// Copyright  2017 DigiPen (USA) Corporation.
+#include "StringTable.h"
+
+using namespace fb;
+
+std::deque<std::string> StringTable::strings;
+std::unordered_map<std::string, StringId> StringTable::ids;
+StringId StringTable::numbers[STRING_TABLE_NUMBERS];
+bool StringTable::numbersReady = false;
+
+StringId StringTable::Intern(const std::string& text)
+{
+  auto found = ids.find(text);
+
+  if (found != ids.end())
+  {
+    return found->second;
+  }
+
+  StringId id = static_cast<StringId>(strings.size());
+  strings.push_back(text);
+  ids.emplace(text, id);
+
+  return id;
+}
+
+const std::string& StringTable::Get(StringId id)
+{
+  return strings[id];
+}
+
+StringId StringTable::Number(int value)
+{
+  if (!numbersReady)
+  {
+    for (int i = 0; i < STRING_TABLE_NUMBERS; ++i)
+    {
+      numbers[i] = Intern(std::to_string(i));
+    }
+
+    numbersReady = true;
+  }
+
+  if (value >= 0 && value < STRING_TABLE_NUMBERS)
+  {
+    return numbers[value];
+  }
+
+  return Intern(std::to_string(value));
+}
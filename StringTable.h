@@ -0,0 +1,63 @@
+// Copyright  2017 DigiPen (USA) Corporation.
+/*!
+*******************************************************************************
+\file    StringTable.h
+\author  James Liao
+\par     email: james.liao\@digipen.edu
+\par     Course: GAM200F17-A
+\brief   Table of interned strings. Each distinct string is stored once and
+         handed out by ID, so hot paths can pass names and popup text around
+         without building new strings.
+*******************************************************************************/
+
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+
+#define STRING_TABLE_NUMBERS 256 //!< Numbers from 0 up to this have their text made up front
+
+namespace fb
+{
+  typedef uint32_t StringId; //!< Handle to an interned string
+
+  class StringTable
+  {
+    public:
+      /*!
+      *******************************************************************************
+      \brief   Stores a string if it isn't already in the table
+      \param   text
+        The string to intern (const std::string &).
+      \return  The ID of the string (StringId).
+      *******************************************************************************/
+      static StringId Intern(const std::string& text);
+
+      /*!
+      *******************************************************************************
+      \brief   Gets the text of an interned string. The reference stays valid
+               for the life of the program.
+      \param   id
+        The ID returned by Intern or Number (StringId).
+      \return  The interned text (const std::string &).
+      *******************************************************************************/
+      static const std::string& Get(StringId id);
+
+      /*!
+      *******************************************************************************
+      \brief   Gets the interned decimal text of a number. Small numbers come
+               from a table made once, others are interned on first use.
+      \param   value
+        The number (int).
+      \return  The ID of the number's text (StringId).
+      *******************************************************************************/
+      static StringId Number(int value);
+
+    private:
+      static std::deque<std::string> strings; //!< Interned text, a deque so references never move
+      static std::unordered_map<std::string, StringId> ids; //!< Looks up the ID of interned text
+      static StringId numbers[STRING_TABLE_NUMBERS]; //!< IDs of the text of 0 to STRING_TABLE_NUMBERS - 1
+      static bool numbersReady; //!< Whether or not the number table has been filled in
+  };
+}
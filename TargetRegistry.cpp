@@ -0,0 +1,41 @@
+// Author:   James Liao
+// Copyright  2017 DigiPen (USA) Corporation.
+#include "TargetRegistry.h"
+
+using namespace fb;
+
+std::unordered_map<const Entity*, TargetInfo> TargetRegistry::targets;
+
+void TargetRegistry::Register(const Entity* entity, TargetCategory category, int index)
+{
+  TargetInfo info;
+  info.category = category;
+  info.index = index;
+
+  targets[entity] = info;
+}
+
+void TargetRegistry::Unregister(const Entity* entity)
+{
+  targets.erase(entity);
+}
+
+TargetInfo TargetRegistry::Find(const Entity* entity)
+{
+  auto iter = targets.find(entity);
+
+  if (iter == targets.end())
+  {
+    TargetInfo none;
+    none.category = TargetNone;
+    none.index = -1;
+    return none;
+  }
+
+  return iter->second;
+}
+
+void TargetRegistry::Clear()
+{
+  targets.clear();
+}
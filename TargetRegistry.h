@@ -0,0 +1,77 @@
+// Copyright  2017 DigiPen (USA) Corporation.
+/*!
+*******************************************************************************
+\file    TargetRegistry.h
+\author  James Liao
+\par     email: james.liao\@digipen.edu
+\par     Course: GAM200F17-A
+\brief   Maps entities to what they are as punch targets, so a hit can be
+         resolved with a single lookup instead of comparing entity names.
+*******************************************************************************/
+
+#pragma once
+#include "Entity.h"
+#include <unordered_map>
+
+namespace fb
+{
+  //! What kind of target an entity is
+  enum TargetCategory
+  {
+    TargetNone,      //!< Not something that reacts to punches
+    TargetCharacter, //!< A fighter, index is the character ID
+    TargetGiant      //!< The giant alien
+  };
+
+  //! Result of looking an entity up in the registry
+  struct TargetInfo
+  {
+    TargetCategory category; //!< What kind of target the entity is
+    int index;               //!< Character ID when category is TargetCharacter, -1 otherwise
+  };
+
+  class TargetRegistry
+  {
+    public:
+      /*!
+      *******************************************************************************
+      \brief   Registers an entity as a punch target
+      \param   entity
+        The entity to register (const Entity *).
+      \param   category
+        What kind of target the entity is (TargetCategory).
+      \param   index
+        Character ID for characters, -1 otherwise (int).
+      \return  None (void).
+      *******************************************************************************/
+      static void Register(const Entity* entity, TargetCategory category, int index = -1);
+
+      /*!
+      *******************************************************************************
+      \brief   Removes an entity from the registry
+      \param   entity
+        The entity to remove (const Entity *).
+      \return  None (void).
+      *******************************************************************************/
+      static void Unregister(const Entity* entity);
+
+      /*!
+      *******************************************************************************
+      \brief   Looks up what kind of target an entity is
+      \param   entity
+        The entity to look up (const Entity *).
+      \return  The target info, with category TargetNone if not registered (TargetInfo).
+      *******************************************************************************/
+      static TargetInfo Find(const Entity* entity);
+
+      /*!
+      *******************************************************************************
+      \brief   Removes every entity from the registry
+      \return  None (void).
+      *******************************************************************************/
+      static void Clear();
+
+    private:
+      static std::unordered_map<const Entity*, TargetInfo> targets; //!< Registered entities
+  };
+}